@@ -0,0 +1,53 @@
+//
+// Mergeable running statistics for simulated payoffs. Uses Welford's update for a single sample and Chan's
+// pairwise update to combine partial results, so workers can accumulate independently and be reduced at the end.
+// Partial results are only bit-for-bit reproducible when they are merged in the same order, see PartialResult.
+//
+
+#include "Accumulator.hpp"
+
+/**
+ * Adds a single payoff to the running statistics using Welford's update
+ * @param payoff The undiscounted payoff of one simulated path
+ * @param delta The pathwise derivative of the payoff with respect to the spot price
+ * @param vega The pathwise derivative of the payoff with respect to the volatility
+ * @param bias The path's estimate of the discretisation bias, see PricerConfig::richardson
+ */
+void Accumulator::add(double payoff, double delta, double vega, double bias)
+{
+    ++count;
+    double n = static_cast<double>(count);
+    double deviation = payoff - mean;
+    mean += deviation / n;
+    M2 += deviation * (payoff - mean);
+    deltaMean += (delta - deltaMean) / n;
+    vegaMean += (vega - vegaMean) / n;
+    biasMean += (bias - biasMean) / n;
+}
+
+/**
+ * Combines the statistics of another Accumulator into this Accumulator
+ * @param other Partial statistics gathered over a disjoint set of paths
+ */
+void Accumulator::merge(const Accumulator& other)
+{
+    if (other.count == 0) return;
+    if (count == 0)
+    {
+        *this = other;
+        return;
+    }
+
+    double n1 = static_cast<double>(count);
+    double n2 = static_cast<double>(other.count);
+    double n = n1 + n2;
+    double deviation = other.mean - mean;
+
+    mean += deviation * n2 / n;
+    M2 += other.M2 + deviation * deviation * n1 * n2 / n;
+    deltaMean += (other.deltaMean - deltaMean) * n2 / n;
+    vegaMean += (other.vegaMean - vegaMean) * n2 / n;
+    biasMean += (other.biasMean - biasMean) * n2 / n;
+    count += other.count;
+    originHits += other.originHits;
+}
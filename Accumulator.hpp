@@ -0,0 +1,31 @@
+//
+// Mergeable running statistics for simulated payoffs. Uses Welford's update for a single sample and Chan's
+// pairwise update to combine partial results, so workers can accumulate independently and be reduced at the end.
+// Partial results are only bit-for-bit reproducible when they are merged in the same order, see PartialResult.
+//
+
+#ifndef MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_ACCUMULATOR_HPP
+#define MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_ACCUMULATOR_HPP
+
+#include <cmath>
+
+struct Accumulator
+{
+    unsigned long count = 0;          // Number of payoffs observed
+    double mean = 0.0;                // Running mean of the payoffs
+    double M2 = 0.0;                  // Sum of squared deviations from the mean
+    unsigned long originHits = 0;     // Number of times S hits the origin
+    double deltaMean = 0.0;           // Running mean of the pathwise derivative of the payoff w.r.t. spot
+    double vegaMean = 0.0;            // Running mean of the pathwise derivative of the payoff w.r.t. volatility
+    double biasMean = 0.0;            // Running mean of the per path estimate of the discretisation bias
+
+    void add(double payoff, double delta = 0.0, double vega = 0.0, double bias = 0.0);
+    void merge(const Accumulator& other);
+
+    inline double variance() const {return count == 0 ? 0.0 : M2 / static_cast<double>(count);}
+    inline double standardDeviation() const {return std::sqrt(variance());}
+    inline double standardError() const {return count == 0 ? 0.0 : standardDeviation() / std::sqrt(static_cast<double>(count));}
+};
+
+
+#endif //MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_ACCUMULATOR_HPP
@@ -0,0 +1,73 @@
+//
+// Closed form Black Scholes prices and greeks of European options on an asset paying a continuous dividend yield,
+// and Black 76 prices of European options on futures. Serves as the reference the Monte Carlo estimates are
+// measured against.
+//
+
+#include "BlackScholes.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace
+{
+    // Standard normal cumulative distribution function
+    double N(double x)
+    {
+        return 0.5 * std::erfc(-x / std::numbers::sqrt2);
+    }
+
+    // Standard normal density
+    double n(double x)
+    {
+        return std::exp(-0.5 * x * x) / std::sqrt(2.0 * std::numbers::pi);
+    }
+}
+
+/**
+ * Prices a European call or put under Black Scholes with dividend yield D
+ * @param optionData The option. type == 1 is a call, anything else a put.
+ * @return The price, delta and vega. An option without time value is worth its discounted intrinsic forward value.
+ */
+BlackScholesResult blackScholes(const OptionData& optionData)
+{
+    const double S = optionData.S, K = optionData.K, T = optionData.T;
+    const double growth = std::exp(-optionData.D * T);        // Discount of the spot for the dividend yield
+    const double discount = std::exp(-optionData.r * T);
+    const double sign = optionData.type == 1 ? 1.0 : -1.0;
+
+    BlackScholesResult result;
+    double stdDev = optionData.sig * std::sqrt(T);
+    if (!(stdDev > 0.0))
+    {
+        double forward = S * growth;
+        double moneyness = sign * (forward - K * discount);
+        result.price = std::max(moneyness, 0.0);
+        result.delta = moneyness > 0.0 ? sign * growth : 0.0;
+        return result;
+    }
+
+    double d1 = (std::log(S / K) + (optionData.r - optionData.D + 0.5 * optionData.sig * optionData.sig) * T) / stdDev;
+    double d2 = d1 - stdDev;
+
+    result.price = sign * (S * growth * N(sign * d1) - K * discount * N(sign * d2));
+    result.delta = sign * growth * N(sign * d1);
+    result.vega = S * growth * n(d1) * std::sqrt(T);
+
+    return result;
+}
+
+/**
+ * Prices a European call or put on a futures contract under Black 76. A future grows at no cost of carry, which is
+ * Black Scholes with a dividend yield equal to the interest rate.
+ * @param optionData The option. S is the futures price, D is ignored.
+ * @return The price, delta w.r.t. the futures price and vega
+ */
+BlackScholesResult black76(const OptionData& optionData)
+{
+    OptionData future = optionData;
+    future.D = optionData.r;
+
+    return blackScholes(future);
+}
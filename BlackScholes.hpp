@@ -0,0 +1,23 @@
+//
+// Closed form Black Scholes prices and greeks of European options on an asset paying a continuous dividend yield,
+// and Black 76 prices of European options on futures. Serves as the reference the Monte Carlo estimates are
+// measured against.
+//
+
+#ifndef MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_BLACKSCHOLES_HPP
+#define MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_BLACKSCHOLES_HPP
+
+#include "OptionData.hpp"
+
+struct BlackScholesResult
+{
+    double price = 0.0;                 // Discounted price
+    double delta = 0.0;                 // Derivative of the price w.r.t. spot
+    double vega = 0.0;                  // Derivative of the price w.r.t. volatility
+};
+
+BlackScholesResult blackScholes(const OptionData& optionData);
+BlackScholesResult black76(const OptionData& optionData);
+
+
+#endif //MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_BLACKSCHOLES_HPP
@@ -0,0 +1,99 @@
+// Calibrate.cpp
+//
+// Calibrates the volatility of the Monte Carlo model to market quotes on frozen random numbers. Reads one quote per
+// line as "K,T,r,S,D,type,price[,weight]" (type 1 == call, -1 == put); blank lines, lines starting with '#' and a
+// header line are skipped. --mode implied finds the implied volatility of every quote, --mode fit fits one
+// volatility to all of them.
+//
+// Usage: Calibrate --quotes quotes.csv [--mode implied|fit] [--vol 0.2] [--nt 100] [--nsim 50000] [--threads n]
+//                  [--engine philox|auto] [--seed n] [--pin policy] [--block-size n] [--max-iterations 50]
+//                  [--tolerance 1e-8]
+//
+
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Calibrator.hpp"
+#include "CommandLine.hpp"
+#include "CsvFile.hpp"
+#include "OptionData.hpp"
+#include "Pricer.hpp"
+#include "PricerOptions.hpp"
+
+namespace
+{
+    // Reads the quotes of a CSV file, using vol as the initial guess of every quote
+    std::vector<CalibrationQuote> readQuotes(const std::string& path, double vol)
+    {
+        std::vector<CalibrationQuote> quotes;
+        for (const auto& record : readCsv(path))
+        {
+            record.expect(7, "K,T,r,S,D,type,price[,weight]");
+            CalibrationQuote quote{OptionData{record.number(0), record.number(1), record.number(2), vol,
+                                              record.number(3), 0ul, record.number(4),
+                                              static_cast<int>(record.number(5))}, record.number(6), 1.0};
+            if (record.fields.size() > 7) quote.weight = record.number(7);
+            quotes.push_back(quote);
+        }
+
+        return quotes;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    CommandLine commandLine(argc, argv);
+    if (!commandLine.has("quotes"))
+    {
+        std::cerr << "Usage: Calibrate --quotes <file> [--mode implied|fit] [--vol <initial guess>] [--nt <n>] "
+                     "[--nsim <n>] [--threads <n>] [--engine <name>] [--seed <n>]" << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        std::vector<CalibrationQuote> quotes = readQuotes(commandLine.get("quotes", ""),
+                                                          commandLine.getDouble("vol", 0.2));
+        std::string mode = commandLine.get("mode", "implied");
+        if (mode != "implied" && mode != "fit") throw std::invalid_argument("Unknown mode " + mode);
+
+        CalibrationConfig config;
+        config.pricer.NT = commandLine.getLong("nt", config.pricer.NT);
+        config.pricer.NSIM = commandLine.getUnsignedLong("nsim", config.pricer.NSIM);
+        readWorkerOptions(commandLine, config.pricer);
+        readEngineOption(commandLine, config.pricer, std::cout);
+        config.maxIterations = static_cast<unsigned int>(commandLine.getLong("max-iterations", config.maxIterations));
+        config.priceTolerance = commandLine.getDouble("tolerance", config.priceTolerance);
+
+        auto start = std::chrono::steady_clock::now();
+        Calibrator calibrator(quotes, config);
+        double cacheSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        CalibrationResult result = mode == "fit" ? calibrator.fitVolatility() : calibrator.impliedVolatilities();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "K, T, Type, Market price, Model price, Standard Error, Vol, Vega, Matched" << std::endl;
+        for (std::size_t q = 0; q < quotes.size(); ++q)
+        {
+            const OptionData& option = quotes[q].optionData;
+            std::cout << option.K << ", " << option.T << ", " << option.type << ", " << quotes[q].price << ", "
+                      << result.prices[q] << ", " << result.standardErrors[q] << ", " << result.vols[q] << ", "
+                      << result.vegas[q] << ", " << (result.matched[q] ? "yes" : "no") << std::endl;
+        }
+        std::cout << "Converged: " << (result.converged ? "yes" : "no") << std::endl;
+        std::cout << "Iterations: " << result.iterations << ", pricing passes: " << result.passes << std::endl;
+        std::cout << "RMS pricing error: " << result.rmse << std::endl;
+        std::cout << "Wall time (s): " << seconds << ", of which generating the paths: " << cacheSeconds << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Unable to calibrate - " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,306 @@
+//
+// Calibrates the volatility of the Euler Monte Carlo model to market quotes. The standard normals of every path are
+// generated once, by the engine and seed the Pricer would use, and cached by the worker that owns the paths. Every
+// iteration then prices all quotes on the same frozen paths (common random numbers), so the model prices are smooth,
+// deterministic functions of the volatility. The pathwise vega of the same pass drives Newton steps for implied
+// volatilities and Levenberg-Marquardt steps for a least squares fit of one volatility to the whole set.
+//
+
+#include "Calibrator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "EngineRegistry.hpp"
+#include "Euler.hpp"
+#include "SDE.hpp"
+
+/**
+ * Overloaded ctor. Generates and caches the normals of every path, each worker the ones of its own paths.
+ * @param _quotes The market quotes
+ * @param _config Discretisation, number of simulations, engine, seed and thread placement of the pricing passes,
+ *                and the stopping rules. See Pricer::standalone for the options a pass ignores.
+ * @throws std::invalid_argument if NT or NSIM is 0, there are no quotes or the volatility bounds are empty
+ */
+Calibrator::Calibrator(std::vector<CalibrationQuote> _quotes, CalibrationConfig _config)
+    : quotes{std::move(_quotes)}, config{std::move(_config)}, pool{config.pricer, topology}
+{
+    PricerConfig& pricer = config.pricer;
+    pricer = Pricer::standalone(std::move(pricer));
+    Pricer::validate(pricer);
+    if (pricer.blockSize == 0) pricer.blockSize = 1;
+    pricer.richardson = false;
+    if (quotes.empty()) throw std::invalid_argument("No quotes to calibrate to");
+    if (!(config.minVol > 0.0 && config.minVol < config.maxVol)) throw std::invalid_argument("Empty volatility bounds");
+
+    blocks = Pricer::blockCount(pricer);
+    increments.resize(pool.size());
+    dispatchEngine(pricer.engine, [&](auto engine)
+    {
+        using Engine = typename decltype(engine)::type;
+        pool.run(blocks, [this](unsigned int worker, std::size_t first, std::size_t last)
+                 { generate<Engine>(worker, first, last); });
+    });
+}
+
+/**
+ * Generates the normals of one worker's range of blocks, path by path exactly as the Pricer draws them
+ * @param worker Index of the worker
+ * @param firstBlock The first block of the worker
+ * @param lastBlock One past the last block of the worker
+ */
+template <typename Engine>
+void Calibrator::generate(unsigned int worker, unsigned long firstBlock, unsigned long lastBlock)
+{
+    const PricerConfig& pricer = config.pricer;
+    unsigned long firstPath = std::min(pricer.NSIM, firstBlock * pricer.blockSize);
+    unsigned long lastPath = std::min(pricer.NSIM, lastBlock * pricer.blockSize);
+    std::size_t steps = static_cast<std::size_t>(pricer.NT);
+
+    std::vector<double>& cache = increments[worker];
+    cache.resize((lastPath - firstPath) * steps);
+
+    Engine rng{pricer.seed};
+    for (unsigned long b = firstBlock; b < lastBlock; ++b)
+    {
+        rng.beginBlock(b);
+        unsigned long blockEnd = std::min(pricer.NSIM, (b + 1) * pricer.blockSize);
+        for (unsigned long path = b * pricer.blockSize; path < blockEnd; ++path)
+        {
+            rng.fillPath(path, cache.data() + (path - firstPath) * steps, steps);
+        }
+    }
+}
+
+/**
+ * Prices the active quotes on the cached paths. Each worker runs its paths through every active quote while the
+ * path's normals are in cache, and keeps the statistics of each quote per block. The pool gives each worker the
+ * same range of blocks it generated.
+ * @param vols Volatility of each quote
+ * @param active The quotes to price
+ * @param estimates Receives the statistics of the undiscounted payoffs and pathwise vegas of each quote
+ */
+void Calibrator::evaluate(const std::vector<double>& vols, const std::vector<bool>& active,
+                          std::vector<Accumulator>& estimates) const
+{
+    std::vector<OptionData> options;
+    std::vector<SDE> sdes;
+    for (std::size_t q = 0; q < quotes.size(); ++q)
+    {
+        OptionData option = quotes[q].optionData;
+        option.sig = vols[q];
+        options.push_back(option);
+        sdes.emplace_back(option);
+    }
+
+    BlockStatistics statistics(pool.size(), quotes.size());
+    pool.run(blocks, [&](unsigned int worker, std::size_t firstBlock, std::size_t lastBlock)
+    {
+        const PricerConfig& pricer = config.pricer;
+        long NT = pricer.NT;
+        std::size_t steps = static_cast<std::size_t>(NT);
+        std::vector<Accumulator>& partial = statistics.allocate(worker, lastBlock - firstBlock);
+        const std::vector<double>& cache = increments[worker];
+        unsigned long firstPath = std::min(pricer.NSIM, firstBlock * pricer.blockSize);
+
+        for (unsigned long b = firstBlock; b < lastBlock; ++b)
+        {
+            Accumulator* block = partial.data() + (b - firstBlock) * options.size();
+            unsigned long blockEnd = std::min(pricer.NSIM, (b + 1) * pricer.blockSize);
+            for (unsigned long path = b * pricer.blockSize; path < blockEnd; ++path)
+            {
+                const double* normals = cache.data() + (path - firstPath) * steps;
+                for (std::size_t q = 0; q < options.size(); ++q)
+                {
+                    if (!active[q]) continue;
+
+                    double k = options[q].T / double (NT);
+                    PathEnd end = euler<1>(sdes[q], options[q].S, normals, NT, k, std::sqrt(k));
+                    double slope = options[q].myPayOffDerivative(end.V);
+                    block[q].originHits += end.originHits;
+                    block[q].add(options[q].myPayOffFunction(end.V), slope * end.V / options[q].S, slope * end.dV);
+                }
+            }
+        }
+    });
+
+    estimates = statistics.reduce();
+}
+
+/**
+ * Stores the discounted prices, vegas and standard errors of a pass along with the volatilities they belong to
+ * @param vols Volatility of each quote
+ * @param estimates The output of evaluate()
+ * @param result Receives the prices, vegas, standard errors and the weighted RMS error
+ */
+void Calibrator::record(const std::vector<double>& vols, const std::vector<Accumulator>& estimates,
+                        CalibrationResult& result) const
+{
+    double squares = 0.0, weights = 0.0;
+    for (std::size_t q = 0; q < quotes.size(); ++q)
+    {
+        if (estimates[q].count == 0) continue;
+
+        const OptionData& option = quotes[q].optionData;
+        double discount = std::exp(-option.r * option.T);
+        result.vols[q] = vols[q];
+        result.prices[q] = discount * estimates[q].mean;
+        result.vegas[q] = discount * estimates[q].vegaMean;
+        result.standardErrors[q] = discount * estimates[q].standardError();
+    }
+    for (std::size_t q = 0; q < quotes.size(); ++q)
+    {
+        double error = result.prices[q] - quotes[q].price;
+        squares += quotes[q].weight * error * error;
+        weights += quotes[q].weight;
+    }
+    result.rmse = weights > 0.0 ? std::sqrt(squares / weights) : 0.0;
+}
+
+/**
+ * Finds the volatility of each quote at which the model reproduces its market price. Every quote takes Newton
+ * steps with its pathwise vega inside a bracket that shrinks with each pass; a step that leaves the bracket is
+ * replaced by bisection. All unmatched quotes are priced in the same pass.
+ * @return The implied volatilities. Quotes outside the prices the volatility bounds can reach stay unmatched.
+ */
+CalibrationResult Calibrator::impliedVolatilities() const
+{
+    std::size_t n = quotes.size();
+    CalibrationResult result;
+    result.vols.assign(n, 0.0);
+    result.prices.assign(n, 0.0);
+    result.vegas.assign(n, 0.0);
+    result.standardErrors.assign(n, 0.0);
+    result.matched.assign(n, false);
+
+    std::vector<double> vols(n), lower(n, config.minVol), upper(n, config.maxVol);
+    for (std::size_t q = 0; q < n; ++q) vols[q] = std::clamp(quotes[q].optionData.sig, config.minVol, config.maxVol);
+
+    std::vector<bool> active(n, true);
+    std::vector<Accumulator> estimates;
+    while (true)
+    {
+        evaluate(vols, active, estimates);
+        result.passes++;
+        record(vols, estimates, result);
+
+        bool pending = false;
+        for (std::size_t q = 0; q < n; ++q)
+        {
+            if (!active[q]) continue;
+
+            double error = result.prices[q] - quotes[q].price;
+            if (std::abs(error) <= config.priceTolerance)
+            {
+                result.matched[q] = true;
+                active[q] = false;
+                continue;
+            }
+
+            // Prices increase with the volatility
+            if (error > 0.0) upper[q] = vols[q];
+            else lower[q] = vols[q];
+            if (upper[q] - lower[q] <= config.volTolerance * std::max(1.0, upper[q]))
+            {
+                active[q] = false;
+                continue;
+            }
+
+            double next = result.vegas[q] > 0.0 ? vols[q] - error / result.vegas[q] : lower[q];
+            if (!(next > lower[q] && next < upper[q])) next = 0.5 * (lower[q] + upper[q]);
+            vols[q] = next;
+            pending = true;
+        }
+
+        if (!pending || result.iterations == config.maxIterations) break;
+        result.iterations++;
+    }
+
+    result.converged = std::all_of(result.matched.begin(), result.matched.end(), [](bool matched) { return matched; });
+
+    return result;
+}
+
+/**
+ * Fits a single volatility to every quote by weighted least squares on the prices. Each Levenberg-Marquardt step
+ * uses the pathwise vegas as the Jacobian; the damping grows after a rejected step and shrinks after an accepted
+ * one.
+ * @return The fitted volatility, repeated for every quote, and the model prices at it
+ */
+CalibrationResult Calibrator::fitVolatility() const
+{
+    std::size_t n = quotes.size();
+    CalibrationResult result;
+    result.vols.assign(n, 0.0);
+    result.prices.assign(n, 0.0);
+    result.vegas.assign(n, 0.0);
+    result.standardErrors.assign(n, 0.0);
+    result.matched.assign(n, false);
+
+    // Weighted mean of the initial guesses
+    double vol = 0.0, weights = 0.0;
+    for (const auto& quote : quotes)
+    {
+        vol += quote.weight * quote.optionData.sig;
+        weights += quote.weight;
+    }
+    vol = std::clamp(weights > 0.0 ? vol / weights : quotes.front().optionData.sig, config.minVol, config.maxVol);
+
+    std::vector<bool> active(n, true);
+    std::vector<Accumulator> estimates;
+    evaluate(std::vector<double>(n, vol), active, estimates);
+    record(std::vector<double>(n, vol), estimates, result);
+
+    unsigned int iterations = 0, passes = 1;
+    double damping = 1e-3;
+    while (iterations < config.maxIterations)
+    {
+        // Gradient and Gauss-Newton curvature of the weighted sum of squared errors
+        double gradient = 0.0, curvature = 0.0;
+        for (std::size_t q = 0; q < n; ++q)
+        {
+            double error = result.prices[q] - quotes[q].price;
+            gradient += quotes[q].weight * result.vegas[q] * error;
+            curvature += quotes[q].weight * result.vegas[q] * result.vegas[q];
+        }
+        if (curvature <= 0.0) break;
+
+        double candidate = std::clamp(vol - gradient / (curvature * (1.0 + damping)), config.minVol, config.maxVol);
+        if (std::abs(candidate - vol) <= config.volTolerance * std::max(1.0, vol))
+        {
+            result.converged = true;
+            break;
+        }
+
+        CalibrationResult trial = result;
+        evaluate(std::vector<double>(n, candidate), active, estimates);
+        record(std::vector<double>(n, candidate), estimates, trial);
+        passes++;
+        iterations++;
+
+        if (trial.rmse < result.rmse)
+        {
+            result = std::move(trial);
+            vol = candidate;
+            damping = std::max(damping / 10.0, 1e-12);
+        }
+        else if ((damping *= 10.0) > 1e12)
+        {
+            // No step in the descent direction helps any more, vol is a minimum up to rounding
+            result.converged = true;
+            break;
+        }
+    }
+    result.iterations = iterations;
+    result.passes = passes;
+
+    for (std::size_t q = 0; q < n; ++q)
+    {
+        result.matched[q] = std::abs(result.prices[q] - quotes[q].price) <= config.priceTolerance;
+    }
+
+    return result;
+}
@@ -0,0 +1,83 @@
+//
+// Calibrates the volatility of the Euler Monte Carlo model to market quotes. The standard normals of every path are
+// generated once, by the engine and seed the Pricer would use, and cached by the worker that owns the paths. Every
+// iteration then prices all quotes on the same frozen paths (common random numbers), so the model prices are smooth,
+// deterministic functions of the volatility. The pathwise vega of the same pass drives Newton steps for implied
+// volatilities and Levenberg-Marquardt steps for a least squares fit of one volatility to the whole set.
+//
+
+#ifndef MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_CALIBRATOR_HPP
+#define MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_CALIBRATOR_HPP
+
+#include <vector>
+
+#include "Accumulator.hpp"
+#include "OptionData.hpp"
+#include "Pricer.hpp"
+#include "Topology.hpp"
+#include "WorkerPool.hpp"
+
+struct CalibrationQuote
+{
+    OptionData optionData;              // The quoted option. Its sig is the initial guess.
+    double price = 0.0;                 // Market price
+    double weight = 1.0;                // Weight of the quote in a least squares fit
+};
+
+struct CalibrationConfig
+{
+    PricerConfig pricer;                // NT, NSIM, engine, seed, block size, threads and placement of the passes
+    unsigned int maxIterations = 50;    // Newton or Levenberg-Marquardt iterations
+    double priceTolerance = 1e-8;       // Pricing error at which an implied volatility is accepted
+    double volTolerance = 1e-10;        // Step size at which a fit is accepted
+    double minVol = 1e-4;               // Lower bound of the volatility
+    double maxVol = 5.0;                // Upper bound of the volatility
+};
+
+struct CalibrationResult
+{
+    std::vector<double> vols;           // Calibrated volatility of each quote. A fit gives every quote the same one.
+    std::vector<double> prices;         // Model prices at the calibrated volatilities
+    std::vector<double> vegas;          // Pathwise vegas at the calibrated volatilities
+    std::vector<double> standardErrors; // Standard errors of the model prices
+    std::vector<bool> matched;          // True for the quotes the model reproduces within the tolerance
+    unsigned int iterations = 0;        // Newton or Levenberg-Marquardt iterations
+    unsigned int passes = 0;            // Pricing passes over the cached paths
+    bool converged = false;             // True if every quote was matched, or the fit stopped moving
+    double rmse = 0.0;                  // Weighted root mean square pricing error
+};
+
+class Calibrator
+{
+private:
+    std::vector<CalibrationQuote> quotes;
+    CalibrationConfig config;
+    Topology topology;
+    WorkerPool pool;
+    unsigned long blocks;
+    std::vector<std::vector<double>> increments;    // Cached normals of each worker's paths
+
+    template <typename Engine>
+    void generate(unsigned int worker, unsigned long firstBlock, unsigned long lastBlock);
+    void evaluate(const std::vector<double>& vols, const std::vector<bool>& active,
+                  std::vector<Accumulator>& estimates) const;
+    void record(const std::vector<double>& vols, const std::vector<Accumulator>& estimates,
+                CalibrationResult& result) const;
+
+public:
+    Calibrator(std::vector<CalibrationQuote> _quotes, CalibrationConfig _config);
+    Calibrator(const Calibrator& other) = default;
+    Calibrator(Calibrator&& other) noexcept = default;
+    virtual ~Calibrator() = default;
+
+    // Operator Overloads
+    Calibrator& operator=(const Calibrator& other) = default;
+    Calibrator& operator=(Calibrator&& other) noexcept = default;
+
+    // Calibration API
+    CalibrationResult impliedVolatilities() const;
+    CalibrationResult fitVolatility() const;
+};
+
+
+#endif //MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_CALIBRATOR_HPP
@@ -0,0 +1,103 @@
+//
+// Periodically writes the state of a running simulation to disk from a background thread. The state is a
+// PartialResult holding every finished block; because each path owns its Philox stream, the finished block indices
+// are the RNG stream positions, and a resumed run only has to price the blocks that are missing. Workers publish
+// finished blocks with a release store and never wait on the checkpointer.
+//
+
+#include "Checkpointer.hpp"
+
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+/**
+ * Overloaded ctor
+ * @param _snapshot Collects the blocks that have been published so far. Called from the checkpointer thread.
+ * @param _path Location of the checkpoint file
+ * @param intervalSeconds Time between two checkpoints
+ * @throws std::invalid_argument if the interval isn't positive, which would checkpoint in a tight loop
+ */
+Checkpointer::Checkpointer(std::function<PartialResult (void)> _snapshot, std::string _path, double intervalSeconds)
+    : snapshot{std::move(_snapshot)}, path{std::move(_path)}, interval{intervalSeconds}
+{
+    if (!(intervalSeconds > 0.0)) throw std::invalid_argument("The checkpoint interval must be positive");
+}
+
+/**
+ * Dtor. Stops the checkpointer thread if the client didn't.
+ */
+Checkpointer::~Checkpointer()
+{
+    if (thread.joinable()) stop();
+}
+
+/**
+ * Starts the checkpointer thread
+ */
+void Checkpointer::start()
+{
+    thread = std::thread{[this] { run(); }};
+}
+
+/**
+ * Writes a final checkpoint and stops the checkpointer thread
+ * @return The number of checkpoints written and the time spent writing them
+ */
+CheckpointMetrics Checkpointer::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock{mtx};
+        stopping = true;
+    }
+    cv.notify_one();
+    if (thread.joinable()) thread.join();
+
+    return metrics;
+}
+
+/**
+ * Takes a checkpoint every interval until stopped, then takes a final one
+ */
+void Checkpointer::run()
+{
+    std::unique_lock<std::mutex> lock{mtx};
+    while (!cv.wait_for(lock, interval, [this] { return stopping; }))
+    {
+        lock.unlock();
+        checkpoint();
+        lock.lock();
+    }
+    lock.unlock();
+
+    checkpoint();
+}
+
+/**
+ * Writes the published blocks to the checkpoint file. A failed write is reported and the run carries on, since
+ * losing a checkpoint only costs the work done since the previous one.
+ */
+void Checkpointer::checkpoint()
+{
+    auto start = std::chrono::steady_clock::now();
+    try
+    {
+        snapshot().write(path);
+
+        std::error_code error;
+        std::uintmax_t size = std::filesystem::file_size(path, error);
+        metrics.bytes = error ? 0 : static_cast<std::size_t>(size);
+        metrics.checkpoints++;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Unable to write checkpoint - " << e.what() << std::endl;
+    }
+    metrics.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
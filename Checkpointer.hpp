@@ -0,0 +1,60 @@
+//
+// Periodically writes the state of a running simulation to disk from a background thread. The state is a
+// PartialResult holding every finished block; because each path owns its Philox stream, the finished block indices
+// are the RNG stream positions, and a resumed run only has to price the blocks that are missing. Workers publish
+// finished blocks with a release store and never wait on the checkpointer.
+//
+
+#ifndef MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_CHECKPOINTER_HPP
+#define MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_CHECKPOINTER_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "PartialResult.hpp"
+
+struct CheckpointMetrics
+{
+    unsigned long checkpoints = 0;      // Number of checkpoints written
+    double seconds = 0.0;               // Time spent taking snapshots and writing them
+    std::size_t bytes = 0;              // Size of the last checkpoint
+};
+
+class Checkpointer
+{
+private:
+    std::function<PartialResult (void)> snapshot;
+    std::string path;
+    std::chrono::duration<double> interval;
+    CheckpointMetrics metrics;
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool stopping = false;
+    std::thread thread;
+
+    void checkpoint();
+    void run();
+
+public:
+    Checkpointer(std::function<PartialResult (void)> _snapshot, std::string _path, double intervalSeconds);
+    Checkpointer(const Checkpointer& other) = delete;
+    Checkpointer(Checkpointer&& other) noexcept = delete;
+    virtual ~Checkpointer();
+
+    // Operator Overloads
+    Checkpointer& operator=(const Checkpointer& other) = delete;
+    Checkpointer& operator=(Checkpointer&& other) noexcept = delete;
+
+    // Lifecycle
+    void start();
+    CheckpointMetrics stop();
+};
+
+
+#endif //MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_CHECKPOINTER_HPP
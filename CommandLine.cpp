@@ -0,0 +1,151 @@
+//
+// Minimal parser for "--flag value" style command line arguments. Flags without a value are stored as switches.
+//
+
+#include "CommandLine.hpp"
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Converts the whole of a flag's value, rejecting values with trailing characters
+    template <typename T, typename Convert>
+    T parse(const std::string& flag, const std::string& value, Convert convert)
+    {
+        std::size_t end = 0;
+        try
+        {
+            T result = convert(value, &end);
+            if (end == value.size()) return result;
+        }
+        catch (const std::logic_error&)
+        {
+        }
+
+        throw std::invalid_argument("Invalid value '" + value + "' for --" + flag);
+    }
+}
+
+/**
+ * Overloaded ctor. Collects every "--flag" argument along with the value that follows it, if any.
+ * @param argc Number of arguments
+ * @param argv The arguments passed to main
+ */
+CommandLine::CommandLine(int argc, char* argv[])
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string flag = argv[i];
+        if (flag.rfind("--", 0) != 0) continue;
+
+        bool hasValue = i + 1 < argc && std::string{argv[i + 1]}.rfind("--", 0) != 0;
+        arguments[flag.substr(2)] = hasValue ? argv[++i] : "";
+    }
+}
+
+/**
+ * Checks whether a flag was given
+ * @param flag The flag name without the leading dashes
+ * @return True if the flag was given. False otherwise.
+ */
+bool CommandLine::has(const std::string& flag) const
+{
+    return arguments.find(flag) != arguments.end();
+}
+
+/**
+ * Looks up the value of a flag
+ * @param flag The flag name without the leading dashes
+ * @param defaultValue Returned when the flag wasn't given
+ * @return The value of the flag
+ */
+std::string CommandLine::get(const std::string& flag, const std::string& defaultValue) const
+{
+    auto it = arguments.find(flag);
+    return it == arguments.end() ? defaultValue : it->second;
+}
+
+/**
+ * Looks up the value of a flag and converts it to a long
+ * @param flag The flag name without the leading dashes
+ * @param defaultValue Returned when the flag wasn't given
+ * @return The value of the flag
+ * @throws std::invalid_argument if the value isn't an integer
+ */
+long CommandLine::getLong(const std::string& flag, long defaultValue) const
+{
+    if (!has(flag)) return defaultValue;
+
+    return parse<long>(flag, get(flag, ""), [](const std::string& v, std::size_t* end) {return std::stol(v, end);});
+}
+
+/**
+ * Looks up the value of a flag and converts it to an unsigned long
+ * @param flag The flag name without the leading dashes
+ * @param defaultValue Returned when the flag wasn't given
+ * @return The value of the flag
+ * @throws std::invalid_argument if the value isn't a non-negative integer
+ */
+unsigned long CommandLine::getUnsignedLong(const std::string& flag, unsigned long defaultValue) const
+{
+    if (!has(flag)) return defaultValue;
+
+    // stoul accepts and wraps negative numbers
+    std::string value = get(flag, "");
+    if (value.find('-') != std::string::npos) throw std::invalid_argument("Invalid value '" + value + "' for --" + flag);
+
+    return parse<unsigned long>(flag, value, [](const std::string& v, std::size_t* end) {return std::stoul(v, end);});
+}
+
+/**
+ * Looks up the value of a flag and converts it to a double
+ * @param flag The flag name without the leading dashes
+ * @param defaultValue Returned when the flag wasn't given
+ * @return The value of the flag
+ * @throws std::invalid_argument if the value isn't a number
+ */
+double CommandLine::getDouble(const std::string& flag, double defaultValue) const
+{
+    if (!has(flag)) return defaultValue;
+
+    return parse<double>(flag, get(flag, ""), [](const std::string& v, std::size_t* end) {return std::stod(v, end);});
+}
+
+/**
+ * Looks up the value of a flag and expands it into a grid of doubles. The value is either an evenly spaced grid
+ * "from:to:count", e.g. "-0.1:0.1:21", or a comma separated list, e.g. "-0.1,0,0.1".
+ * @param flag The flag name without the leading dashes
+ * @param defaultValue Returned when the flag wasn't given
+ * @return The points of the grid
+ */
+std::vector<double> CommandLine::getGrid(const std::string& flag, const std::vector<double>& defaultValue) const
+{
+    if (!has(flag)) return defaultValue;
+
+    std::string value = get(flag, "");
+    std::vector<double> grid;
+    if (value.find(':') != std::string::npos)
+    {
+        std::size_t first = value.find(':');
+        std::size_t second = value.find(':', first + 1);
+        if (second == std::string::npos) throw std::invalid_argument("Expected from:to:count for --" + flag);
+
+        double from = std::stod(value.substr(0, first));
+        double to = std::stod(value.substr(first + 1, second - first - 1));
+        long count = std::stol(value.substr(second + 1));
+        if (count < 1) throw std::invalid_argument("Expected a positive count for --" + flag);
+
+        for (long i = 0; i < count; ++i) grid.push_back(count == 1 ? from : from + (to - from) * i / (count - 1));
+    }
+    else
+    {
+        std::stringstream stream{value};
+        std::string token;
+        while (std::getline(stream, token, ',')) grid.push_back(std::stod(token));
+    }
+
+    return grid;
+}
@@ -0,0 +1,38 @@
+//
+// Minimal parser for "--flag value" style command line arguments. Flags without a value are stored as switches.
+//
+
+#ifndef MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_COMMANDLINE_HPP
+#define MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_COMMANDLINE_HPP
+
+#include <map>
+#include <string>
+#include <vector>
+
+class CommandLine
+{
+private:
+    std::map<std::string, std::string> arguments;
+
+public:
+    CommandLine() = default;
+    CommandLine(int argc, char* argv[]);
+    CommandLine(const CommandLine& other) = default;
+    CommandLine(CommandLine&& other) noexcept = default;
+    virtual ~CommandLine() = default;
+
+    // Operator Overloads
+    CommandLine& operator=(const CommandLine& other) = default;
+    CommandLine& operator=(CommandLine&& other) noexcept = default;
+
+    // Accessors
+    bool has(const std::string& flag) const;
+    std::string get(const std::string& flag, const std::string& defaultValue) const;
+    long getLong(const std::string& flag, long defaultValue) const;
+    unsigned long getUnsignedLong(const std::string& flag, unsigned long defaultValue) const;
+    double getDouble(const std::string& flag, double defaultValue) const;
+    std::vector<double> getGrid(const std::string& flag, const std::vector<double>& defaultValue) const;
+};
+
+
+#endif //MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_COMMANDLINE_HPP
@@ -0,0 +1,126 @@
+// Convergence.cpp
+//
+// Efficiency report of the pricer. Prices the reference options of ConvergenceStudy against their Black Scholes
+// prices over a sweep of engines, schemes, time steps, simulations and thread counts, each configuration replicated
+// over --replications consecutive seeds, and writes the bias, RMSE, standard error, wall and CPU time of every
+// configuration as CSV and/or JSON. The configurations on the efficiency frontier are printed.
+//
+// Usage: Convergence [--engines philox,mersenne-twister] [--schemes euler,richardson] [--nt-grid 10,50,100]
+//                    [--nsim-grid 1000,10000,100000] [--threads-grid 1,4] [--replications 8] [--seed n]
+//                    [--block-size n] [--pin policy] [--csv out.csv] [--json out.json]
+//
+
+#include <cmath>
+#include <exception>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "CommandLine.hpp"
+#include "ConvergenceStudy.hpp"
+#include "EngineRegistry.hpp"
+#include "Pricer.hpp"
+#include "PricerOptions.hpp"
+
+namespace
+{
+    constexpr double MAX_COUNT = 1e15;      // Beyond this a double no longer holds every whole number exactly
+
+    /**
+     * Reads a grid of counts, e.g. --nt-grid 10,50,100
+     * @param commandLine The arguments of the program
+     * @param flag Name of the grid
+     * @param defaultValue Grid if the flag isn't given
+     * @param max Largest count allowed
+     * @return The points of the grid, each a whole number from 1 to max
+     * @throws std::invalid_argument if a point isn't a number, isn't whole or is out of range
+     */
+    std::vector<double> readCounts(const CommandLine& commandLine, const std::string& flag,
+                                   const std::vector<double>& defaultValue, double max)
+    {
+        std::vector<double> grid = commandLine.getGrid(flag, defaultValue);
+        for (double point : grid)
+        {
+            if (!(point >= 1.0 && point <= max) || point != std::floor(point))
+            {
+                throw std::invalid_argument("Invalid point " + std::to_string(point) + " of --" + flag +
+                                            ", expected a whole number from 1");
+            }
+        }
+
+        return grid;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    CommandLine commandLine(argc, argv);
+
+    try
+    {
+        PricerConfig config;
+        readWorkerOptions(commandLine, config);
+
+        std::vector<EngineId> engines;
+        std::stringstream names{commandLine.get("engines", "philox")};
+        std::string name;
+        while (std::getline(names, name, ',')) engines.push_back(getEngineIdFromName(name));
+
+        std::vector<bool> schemes;
+        std::stringstream schemeNames{commandLine.get("schemes", "euler")};
+        while (std::getline(schemeNames, name, ','))
+        {
+            if (name != "euler" && name != "richardson") throw std::invalid_argument("Unknown scheme " + name);
+            schemes.push_back(name == "richardson");
+        }
+
+        std::vector<long> NTs;
+        for (double NT : readCounts(commandLine, "nt-grid", {10, 25, 50, 100, 200}, MAX_COUNT))
+        {
+            NTs.push_back(static_cast<long>(NT));
+        }
+
+        std::vector<unsigned long> NSIMs;
+        for (double NSIM : readCounts(commandLine, "nsim-grid", {1000, 4000, 16000, 64000}, MAX_COUNT))
+        {
+            NSIMs.push_back(static_cast<unsigned long>(NSIM));
+        }
+
+        std::vector<unsigned int> threads;
+        std::vector<double> defaultThreads{static_cast<double>(config.threads)};
+        for (double workers : readCounts(commandLine, "threads-grid", defaultThreads, MAX_THREADS))
+        {
+            threads.push_back(static_cast<unsigned int>(workers));
+        }
+
+        unsigned long replications = commandLine.getUnsignedLong("replications", 8);
+
+        ConvergenceStudy study(ConvergenceStudy::referenceCases(), config, engines, schemes, NTs, NSIMs, threads,
+                               replications);
+        std::vector<ConvergencePoint> points = study.run();
+
+        if (commandLine.has("csv")) ConvergenceStudy::writeCsv(commandLine.get("csv", ""), points);
+        if (commandLine.has("json")) ConvergenceStudy::writeJson(commandLine.get("json", ""), points);
+
+        std::cout << "\nEfficiency frontier\n";
+        std::cout << "Case, Engine, Scheme, NT, NSIM, Threads, Bias, Bias Standard Error, RMSE, Standard Error, "
+                     "CPU time per run (s), Efficiency" << std::endl;
+        for (const auto& point : points)
+        {
+            if (!point.frontier) continue;
+            std::cout << point.caseName << ", " << point.engine << ", " << point.scheme << ", " << point.NT << ", "
+                      << point.NSIM << ", " << point.threads << ", " << point.bias << ", " << point.biasStandardError
+                      << ", " << point.rmse << ", " << point.standardError << ", " << point.cpuSeconds << ", "
+                      << point.efficiency << std::endl;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Unable to run the convergence study - " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
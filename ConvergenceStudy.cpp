@@ -0,0 +1,255 @@
+//
+// Convergence harness. Prices a reference set of options with known Black Scholes prices over a sweep of engines,
+// schemes, time steps, simulations and thread counts. Every configuration is replicated over consecutive seeds, and
+// the errors of the replications give its bias with a standard error and its root mean squared error, which holds
+// both the bias and the noise. The efficiency of a configuration is 1 / (RMSE^2 * CPU seconds per run), the accuracy
+// it buys per core-second. The configurations that no other configuration of the same option beats on both RMSE and
+// CPU time form the efficiency frontier.
+//
+
+#include "ConvergenceStudy.hpp"
+
+#include <cmath>
+#include <ctime>
+#include <fstream>
+#include <ios>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Accumulator.hpp"
+#include "BlackScholes.hpp"
+
+namespace
+{
+    // CPU time consumed so far by every thread of the process
+    double processCpuSeconds()
+    {
+        return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+    }
+
+    // Infinite efficiencies of exact runs aren't valid JSON
+    std::string jsonNumber(double value)
+    {
+        if (!std::isfinite(value)) return "null";
+
+        std::ostringstream out;
+        out.precision(std::numeric_limits<double>::max_digits10);
+        out << value;
+        return out.str();
+    }
+}
+
+/**
+ * Overloaded ctor
+ * @param _cases The options to price
+ * @param _config Template of every run: seed, block size and thread placement. See Pricer::standalone for the
+ *                options a run ignores.
+ * @param _engines Engines to sweep
+ * @param _schemes Schemes to sweep, false for plain Euler and true for Richardson extrapolation
+ * @param _NTs Numbers of time steps to sweep
+ * @param _NSIMs Numbers of simulations to sweep
+ * @param _threads Numbers of workers to sweep
+ * @param _replications Runs per configuration, with consecutive seeds from the seed of the config
+ * @throws std::invalid_argument if there are fewer than 2 replications, which can't estimate the spread of the errors
+ */
+ConvergenceStudy::ConvergenceStudy(std::vector<ConvergenceCase> _cases, PricerConfig _config,
+                                   std::vector<EngineId> _engines, std::vector<bool> _schemes,
+                                   std::vector<long> _NTs, std::vector<unsigned long> _NSIMs,
+                                   std::vector<unsigned int> _threads, unsigned long _replications)
+    : cases{std::move(_cases)}, config{Pricer::standalone(std::move(_config))}, engines{std::move(_engines)},
+      schemes{std::move(_schemes)}, NTs{std::move(_NTs)}, NSIMs{std::move(_NSIMs)}, threads{std::move(_threads)},
+      replications{_replications}
+{
+    if (replications < 2)
+    {
+        throw std::invalid_argument("Invalid number of replications " + std::to_string(replications) +
+                                    ", expected at least 2");
+    }
+
+    if (engines.empty()) engines.push_back(config.engine);
+    if (schemes.empty()) schemes.push_back(config.richardson);
+    if (NTs.empty()) NTs.push_back(config.NT);
+    if (NSIMs.empty()) NSIMs.push_back(config.NSIM);
+    if (threads.empty()) threads.push_back(config.threads);
+}
+
+/**
+ * A small set of options with known prices: the textbook put of TestMC, an at the money call, a call on a dividend
+ * paying asset and a long dated in the money put
+ * @return The reference cases
+ */
+std::vector<ConvergenceCase> ConvergenceStudy::referenceCases()
+{
+    return {
+        {"textbook-put", OptionData{65.0, 0.25, 0.08, 0.3, 60.0, 0ul, 0.0, -1}},
+        {"atm-call", OptionData{100.0, 1.0, 0.05, 0.2, 100.0, 0ul, 0.0, 1}},
+        {"dividend-call", OptionData{110.0, 0.5, 0.05, 0.25, 100.0, 0ul, 0.03, 1}},
+        {"long-itm-put", OptionData{120.0, 2.0, 0.03, 0.4, 100.0, 0ul, 0.0, -1}}
+    };
+}
+
+/**
+ * Prices one case under one configuration once per replication and measures the runs
+ * @param reference The case
+ * @param exact Black Scholes price of the case
+ * @param runConfig Configuration of the runs. Replication i runs with the seed of the config plus i.
+ * @return The statistics of the runs, without the frontier flag
+ */
+ConvergencePoint ConvergenceStudy::measure(const ConvergenceCase& reference, double exact,
+                                           PricerConfig runConfig) const
+{
+    OptionData optionData = reference.optionData;
+    optionData.NSIM = runConfig.NSIM;
+
+    // The errors in an Accumulator give their mean and spread; the payoff moments of each run give its standard error
+    Accumulator errors;
+    double squaredErrors = 0.0, prices = 0.0, standardErrors = 0.0, wallSeconds = 0.0, cpuSeconds = 0.0;
+    double discount = std::exp(-optionData.r * optionData.T);
+    for (unsigned long replication = 0; replication < replications; ++replication)
+    {
+        runConfig.seed = config.seed + replication;
+
+        double cpuStart = processCpuSeconds();
+        PricerResult result = Pricer(optionData, runConfig).price();
+        cpuSeconds += processCpuSeconds() - cpuStart;
+
+        double error = result.price - exact;
+        errors.add(error);
+        squaredErrors += error * error;
+        prices += result.price;
+        standardErrors += discount * result.payoffs.standardError();
+        wallSeconds += result.metrics.wallSeconds;
+    }
+    auto runs = static_cast<double>(replications);
+
+    ConvergencePoint point;
+    point.caseName = reference.name;
+    point.engine = getEngineName(runConfig.engine);
+    point.scheme = runConfig.richardson ? "richardson" : "euler";
+    point.NT = runConfig.NT;
+    point.NSIM = runConfig.NSIM;
+    point.threads = runConfig.threads;
+    point.replications = replications;
+    point.reference = exact;
+    point.price = prices / runs;
+    point.bias = errors.mean;
+    point.biasStandardError = std::sqrt(errors.M2 / (runs - 1.0) / runs);
+    point.rmse = std::sqrt(squaredErrors / runs);
+    point.standardError = standardErrors / runs;
+    point.wallSeconds = wallSeconds / runs;
+    point.cpuSeconds = cpuSeconds / runs;
+    double cost = point.rmse * point.rmse * point.cpuSeconds;
+    point.efficiency = cost > 0.0 ? 1.0 / cost : std::numeric_limits<double>::infinity();
+
+    return point;
+}
+
+/**
+ * Runs every combination of case, engine, scheme, thread count, time steps and simulations, replicated over
+ * consecutive seeds, one run after the other so the timings don't interfere
+ * @return One point per configuration, in sweep order, with the efficiency frontier of each case marked
+ */
+std::vector<ConvergencePoint> ConvergenceStudy::run() const
+{
+    std::vector<ConvergencePoint> points;
+    for (const auto& reference : cases)
+    {
+        double exact = blackScholes(reference.optionData).price;
+        std::size_t firstPoint = points.size();
+
+        PricerConfig runConfig = config;
+        for (EngineId engine : engines)
+        {
+            runConfig.engine = engine;
+            for (bool richardson : schemes)
+            {
+                runConfig.richardson = richardson;
+                for (unsigned int workers : threads)
+                {
+                    runConfig.threads = workers;
+                    for (long NT : NTs)
+                    {
+                        runConfig.NT = NT;
+                        for (unsigned long NSIM : NSIMs)
+                        {
+                            runConfig.NSIM = NSIM;
+                            points.push_back(measure(reference, exact, runConfig));
+                        }
+                    }
+                }
+            }
+        }
+
+        // Pareto frontier of the case on (rmse, cpuSeconds)
+        for (std::size_t i = firstPoint; i < points.size(); ++i)
+        {
+            bool dominated = false;
+            double error = points[i].rmse;
+            for (std::size_t j = firstPoint; j < points.size() && !dominated; ++j)
+            {
+                double other = points[j].rmse;
+                dominated = other <= error && points[j].cpuSeconds <= points[i].cpuSeconds &&
+                            (other < error || points[j].cpuSeconds < points[i].cpuSeconds);
+            }
+            points[i].frontier = !dominated;
+        }
+    }
+
+    return points;
+}
+
+/**
+ * Writes the points as CSV with a header row
+ * @param path Location of the file
+ * @param points The output of run()
+ */
+void ConvergenceStudy::writeCsv(const std::string& path, const std::vector<ConvergencePoint>& points)
+{
+    std::ofstream out{path, std::ios::trunc};
+    if (!out) throw std::runtime_error("Unable to open " + path);
+
+    out.precision(std::numeric_limits<double>::max_digits10);
+    out << "case,engine,scheme,nt,nsim,threads,replications,reference,price,bias,bias_standard_error,rmse,"
+           "standard_error,wall_seconds,cpu_seconds,efficiency,frontier\n";
+    for (const auto& p : points)
+    {
+        out << p.caseName << ',' << p.engine << ',' << p.scheme << ',' << p.NT << ',' << p.NSIM << ',' << p.threads
+            << ',' << p.replications << ',' << p.reference << ',' << p.price << ',' << p.bias << ','
+            << p.biasStandardError << ',' << p.rmse << ',' << p.standardError << ',' << p.wallSeconds << ','
+            << p.cpuSeconds << ',' << p.efficiency << ',' << (p.frontier ? 1 : 0) << '\n';
+    }
+    if (!out) throw std::runtime_error("Unable to write " + path);
+}
+
+/**
+ * Writes the points as a JSON array of objects
+ * @param path Location of the file
+ * @param points The output of run()
+ */
+void ConvergenceStudy::writeJson(const std::string& path, const std::vector<ConvergencePoint>& points)
+{
+    std::ofstream out{path, std::ios::trunc};
+    if (!out) throw std::runtime_error("Unable to open " + path);
+
+    out.precision(std::numeric_limits<double>::max_digits10);
+    out << "[\n";
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        const ConvergencePoint& p = points[i];
+        out << "  {\"case\": \"" << p.caseName << "\", \"engine\": \"" << p.engine << "\", \"scheme\": \""
+            << p.scheme << "\", \"nt\": " << p.NT << ", \"nsim\": " << p.NSIM << ", \"threads\": " << p.threads
+            << ", \"replications\": " << p.replications << ", \"reference\": " << p.reference << ", \"price\": "
+            << p.price << ", \"bias\": " << p.bias << ", \"bias_standard_error\": " << p.biasStandardError
+            << ", \"rmse\": " << p.rmse << ", \"standard_error\": " << p.standardError << ", \"wall_seconds\": "
+            << p.wallSeconds
+            << ", \"cpu_seconds\": " << p.cpuSeconds << ", \"efficiency\": " << jsonNumber(p.efficiency)
+            << ", \"frontier\": " << (p.frontier ? "true" : "false") << "}" << (i + 1 < points.size() ? "," : "")
+            << '\n';
+    }
+    out << "]\n";
+    if (!out) throw std::runtime_error("Unable to write " + path);
+}
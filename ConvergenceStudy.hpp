@@ -0,0 +1,83 @@
+//
+// Convergence harness. Prices a reference set of options with known Black Scholes prices over a sweep of engines,
+// schemes, time steps, simulations and thread counts. Every configuration is replicated over consecutive seeds, and
+// the errors of the replications give its bias with a standard error and its root mean squared error, which holds
+// both the bias and the noise. The efficiency of a configuration is 1 / (RMSE^2 * CPU seconds per run), the accuracy
+// it buys per core-second. The configurations that no other configuration of the same option beats on both RMSE and
+// CPU time form the efficiency frontier.
+//
+
+#ifndef MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_CONVERGENCESTUDY_HPP
+#define MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_CONVERGENCESTUDY_HPP
+
+#include <string>
+#include <vector>
+
+#include "EngineRegistry.hpp"
+#include "OptionData.hpp"
+#include "Pricer.hpp"
+
+struct ConvergenceCase
+{
+    std::string name;                   // Label of the option in the report
+    OptionData optionData;              // The option. Its NSIM is ignored in favour of the sweep.
+};
+
+struct ConvergencePoint
+{
+    std::string caseName;               // The option that was priced
+    std::string engine;                 // Name of the engine
+    std::string scheme;                 // "euler", or "richardson" for Euler extrapolated from NT and 2 NT steps
+    long NT = 0;                        // Number of time steps
+    unsigned long NSIM = 0;             // Number of simulations
+    unsigned int threads = 0;           // Number of workers
+    unsigned long replications = 0;     // Number of runs, with seeds seed to seed + replications - 1
+    double reference = 0.0;             // Black Scholes price
+    double price = 0.0;                 // Mean Monte Carlo price of the runs
+    double bias = 0.0;                  // Mean of price - reference over the runs
+    double biasStandardError = 0.0;     // Standard error of the bias, from the spread of the errors of the runs
+    double rmse = 0.0;                  // Root mean squared error of the runs
+    double standardError = 0.0;         // Mean standard error of the discounted price of one run
+    double wallSeconds = 0.0;           // Mean wall time of one run
+    double cpuSeconds = 0.0;            // Mean CPU time of one run, summed over every thread of the process
+    double efficiency = 0.0;            // 1 / (rmse^2 * cpuSeconds)
+    bool frontier = false;              // True if no point of the same option has both a lower RMSE and CPU time
+};
+
+class ConvergenceStudy
+{
+private:
+    std::vector<ConvergenceCase> cases;
+    PricerConfig config;
+    std::vector<EngineId> engines;
+    std::vector<bool> schemes;          // Richardson extrapolation off or on
+    std::vector<long> NTs;
+    std::vector<unsigned long> NSIMs;
+    std::vector<unsigned int> threads;
+    unsigned long replications;         // Runs per configuration
+
+    ConvergencePoint measure(const ConvergenceCase& reference, double exact, PricerConfig runConfig) const;
+
+public:
+    ConvergenceStudy(std::vector<ConvergenceCase> _cases, PricerConfig _config, std::vector<EngineId> _engines,
+                     std::vector<bool> _schemes, std::vector<long> _NTs, std::vector<unsigned long> _NSIMs,
+                     std::vector<unsigned int> _threads, unsigned long _replications);
+    ConvergenceStudy(const ConvergenceStudy& other) = default;
+    ConvergenceStudy(ConvergenceStudy&& other) noexcept = default;
+    virtual ~ConvergenceStudy() = default;
+
+    // Operator Overloads
+    ConvergenceStudy& operator=(const ConvergenceStudy& other) = default;
+    ConvergenceStudy& operator=(ConvergenceStudy&& other) noexcept = default;
+
+    // Study API
+    std::vector<ConvergencePoint> run() const;
+    static std::vector<ConvergenceCase> referenceCases();
+
+    // Reports
+    static void writeCsv(const std::string& path, const std::vector<ConvergencePoint>& points);
+    static void writeJson(const std::string& path, const std::vector<ConvergencePoint>& points);
+};
+
+
+#endif //MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_CONVERGENCESTUDY_HPP
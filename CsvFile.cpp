@@ -0,0 +1,80 @@
+//
+// Reader of the comma separated input files of the batch programs. Blank lines, lines starting with '#' and a header
+// line (any line starting with a letter) are skipped; every other line is one record.
+//
+
+#include "CsvFile.hpp"
+
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * Checks that the record has at least the fields of a layout
+ * @param count Number of fields the layout requires
+ * @param layout The layout, e.g. "K,T,r,sig,S,D,type", for the error message
+ * @throws std::runtime_error if the record has fewer fields
+ */
+void CsvRecord::expect(std::size_t count, const std::string& layout) const
+{
+    if (fields.size() < count)
+    {
+        throw std::runtime_error("Expected " + layout + " on line " + std::to_string(line));
+    }
+}
+
+/**
+ * Converts a field to a double
+ * @param field Index of the field
+ * @return The value of the field
+ * @throws std::runtime_error if the field is missing or isn't a number
+ */
+double CsvRecord::number(std::size_t field) const
+{
+    if (field < fields.size())
+    {
+        const std::string& value = fields[field];
+        std::size_t end = 0;
+        try
+        {
+            double result = std::stod(value, &end);
+            if (value.find_first_not_of(" \t\r", end) == std::string::npos) return result;
+        }
+        catch (const std::logic_error&)
+        {
+        }
+    }
+
+    throw std::runtime_error("Expected a number in field " + std::to_string(field + 1) + " on line " +
+                             std::to_string(line));
+}
+
+/**
+ * Reads every record of a file
+ * @param path Location of the file
+ * @return The records in file order
+ * @throws std::runtime_error if the file can't be opened
+ */
+std::vector<CsvRecord> readCsv(const std::string& path)
+{
+    std::ifstream in{path};
+    if (!in) throw std::runtime_error("Unable to open " + path);
+
+    std::vector<CsvRecord> records;
+    std::string line;
+    for (std::size_t number = 1; std::getline(in, line); ++number)
+    {
+        if (line.empty() || line[0] == '#' || std::isalpha(static_cast<unsigned char>(line[0]))) continue;
+
+        CsvRecord record{number, {}};
+        std::stringstream stream{line};
+        std::string field;
+        while (std::getline(stream, field, ',')) record.fields.push_back(field);
+        records.push_back(record);
+    }
+
+    return records;
+}
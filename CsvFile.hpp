@@ -0,0 +1,25 @@
+//
+// Reader of the comma separated input files of the batch programs. Blank lines, lines starting with '#' and a header
+// line (any line starting with a letter) are skipped; every other line is one record.
+//
+
+#ifndef MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_CSVFILE_HPP
+#define MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_CSVFILE_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+struct CsvRecord
+{
+    std::size_t line = 0;               // Line number in the file, counting from 1
+    std::vector<std::string> fields;    // The comma separated fields of the line
+
+    void expect(std::size_t count, const std::string& layout) const;
+    double number(std::size_t field) const;
+};
+
+std::vector<CsvRecord> readCsv(const std::string& path);
+
+
+#endif //MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_CSVFILE_HPP
@@ -0,0 +1,161 @@
+//
+// Mergeable quantile sketch with a relative accuracy guarantee. Values are counted in logarithmically spaced
+// buckets, bucket i holding the magnitudes in (gamma^(i-1), gamma^i] with gamma = (1 + alpha) / (1 - alpha), so
+// every quantile is returned within a relative error alpha of the true sample quantile. Negative values and zeros
+// are counted separately. Merging adds the bucket counts, so per-thread sketches can be combined in any order and
+// still give the same result.
+//
+
+#include "DistributionSketch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Adds n to a bucket, growing the dense bucket range to include it
+    void increment(std::vector<unsigned long>& buckets, int& offset, int bucket, unsigned long n)
+    {
+        if (buckets.empty())
+        {
+            offset = bucket;
+            buckets.push_back(0);
+        }
+        if (bucket < offset)
+        {
+            buckets.insert(buckets.begin(), static_cast<std::size_t>(offset - bucket), 0);
+            offset = bucket;
+        }
+        else if (bucket >= offset + static_cast<int>(buckets.size()))
+        {
+            buckets.resize(static_cast<std::size_t>(bucket - offset) + 1, 0);
+        }
+        buckets[static_cast<std::size_t>(bucket - offset)] += n;
+    }
+}
+
+/**
+ * Overloaded ctor
+ * @param relativeAccuracy Relative error alpha of the quantiles, 0 < alpha < 1
+ */
+DistributionSketch::DistributionSketch(double relativeAccuracy)
+    : alpha{relativeAccuracy}
+{
+    if (!(alpha > 0.0 && alpha < 1.0)) throw std::invalid_argument("Relative accuracy must be in (0, 1)");
+
+    gamma = (1.0 + alpha) / (1.0 - alpha);
+    logGamma = std::log(gamma);
+}
+
+/**
+ * Index of the bucket holding a positive magnitude
+ * @param magnitude A value of at least MIN_MAGNITUDE
+ * @return The smallest i with magnitude <= gamma^i
+ */
+int DistributionSketch::bucketOf(double magnitude) const
+{
+    return static_cast<int>(std::ceil(std::log(magnitude) / logGamma));
+}
+
+/**
+ * Representative magnitude of a bucket, within a relative error alpha of every magnitude in the bucket
+ * @param bucket Index of the bucket
+ * @return 2 gamma^i / (gamma + 1)
+ */
+double DistributionSketch::valueOf(int bucket) const
+{
+    return 2.0 * std::exp(bucket * logGamma) / (gamma + 1.0);
+}
+
+/**
+ * Counts a value
+ * @param value The value. NaNs are ignored.
+ */
+void DistributionSketch::add(double value)
+{
+    if (std::isnan(value)) return;
+
+    minimum = total == 0 ? value : std::min(minimum, value);
+    maximum = total == 0 ? value : std::max(maximum, value);
+    total++;
+
+    if (value > MIN_MAGNITUDE) increment(positive, positiveOffset, bucketOf(value), 1);
+    else if (value < -MIN_MAGNITUDE) increment(negative, negativeOffset, bucketOf(-value), 1);
+    else zeros++;
+}
+
+/**
+ * Adds the counts of another sketch
+ * @param other A sketch with the same relative accuracy
+ * @throws std::invalid_argument if the sketches have different relative accuracies
+ */
+void DistributionSketch::merge(const DistributionSketch& other)
+{
+    if (other.alpha != alpha) throw std::invalid_argument("Sketches with different relative accuracies can't be merged");
+    if (other.total == 0) return;
+
+    minimum = total == 0 ? other.minimum : std::min(minimum, other.minimum);
+    maximum = total == 0 ? other.maximum : std::max(maximum, other.maximum);
+    total += other.total;
+    zeros += other.zeros;
+
+    for (std::size_t i = 0; i < other.positive.size(); ++i)
+    {
+        if (other.positive[i] != 0) increment(positive, positiveOffset, other.positiveOffset + static_cast<int>(i), other.positive[i]);
+    }
+    for (std::size_t i = 0; i < other.negative.size(); ++i)
+    {
+        if (other.negative[i] != 0) increment(negative, negativeOffset, other.negativeOffset + static_cast<int>(i), other.negative[i]);
+    }
+}
+
+/**
+ * Estimates a quantile of the values counted so far
+ * @param q The probability, 0 <= q <= 1
+ * @return The estimate of the q-quantile, within a relative error alpha. 0 for an empty sketch.
+ */
+double DistributionSketch::quantile(double q) const
+{
+    if (total == 0) return 0.0;
+
+    // Rank of the quantile among the values in ascending order
+    unsigned long rank = static_cast<unsigned long>(std::clamp(q, 0.0, 1.0) * static_cast<double>(total - 1));
+
+    double estimate = maximum;
+    unsigned long seen = 0;
+    bool found = false;
+
+    // Negative values, most negative first
+    for (std::size_t i = negative.size(); i-- > 0 && !found;)
+    {
+        seen += negative[i];
+        if (seen > rank)
+        {
+            estimate = -valueOf(negativeOffset + static_cast<int>(i));
+            found = true;
+        }
+    }
+    if (!found)
+    {
+        seen += zeros;
+        if (seen > rank)
+        {
+            estimate = 0.0;
+            found = true;
+        }
+    }
+    for (std::size_t i = 0; i < positive.size() && !found; ++i)
+    {
+        seen += positive[i];
+        if (seen > rank)
+        {
+            estimate = valueOf(positiveOffset + static_cast<int>(i));
+            found = true;
+        }
+    }
+
+    return std::clamp(estimate, minimum, maximum);
+}
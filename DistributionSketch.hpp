@@ -0,0 +1,57 @@
+//
+// Mergeable quantile sketch with a relative accuracy guarantee. Values are counted in logarithmically spaced
+// buckets, bucket i holding the magnitudes in (gamma^(i-1), gamma^i] with gamma = (1 + alpha) / (1 - alpha), so
+// every quantile is returned within a relative error alpha of the true sample quantile. Negative values and zeros
+// are counted separately. Merging adds the bucket counts, so per-thread sketches can be combined in any order and
+// still give the same result.
+//
+
+#ifndef MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_DISTRIBUTIONSKETCH_HPP
+#define MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_DISTRIBUTIONSKETCH_HPP
+
+#include <vector>
+
+class DistributionSketch
+{
+private:
+    double alpha;
+    double gamma;
+    double logGamma;
+
+    std::vector<unsigned long> positive;    // Buckets of the positive values, the first one has index positiveOffset
+    int positiveOffset = 0;
+    std::vector<unsigned long> negative;    // Buckets of the magnitudes of the negative values
+    int negativeOffset = 0;
+    unsigned long zeros = 0;                // Values too small to be told apart from zero
+    unsigned long total = 0;
+    double minimum = 0.0;
+    double maximum = 0.0;
+
+    int bucketOf(double magnitude) const;
+    double valueOf(int bucket) const;
+
+public:
+    static constexpr double MIN_MAGNITUDE = 1e-12;  // Smaller magnitudes are counted as zero
+
+    explicit DistributionSketch(double relativeAccuracy = 0.005);
+    DistributionSketch(const DistributionSketch& other) = default;
+    DistributionSketch(DistributionSketch&& other) noexcept = default;
+    virtual ~DistributionSketch() = default;
+
+    // Operator Overloads
+    DistributionSketch& operator=(const DistributionSketch& other) = default;
+    DistributionSketch& operator=(DistributionSketch&& other) noexcept = default;
+
+    // Sketch API
+    void add(double value);
+    void merge(const DistributionSketch& other);
+    double quantile(double q) const;
+
+    inline unsigned long count() const {return total;}
+    inline double min() const {return minimum;}
+    inline double max() const {return maximum;}
+    inline double relativeAccuracy() const {return alpha;}
+};
+
+
+#endif //MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_DISTRIBUTIONSKETCH_HPP
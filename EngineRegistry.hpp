@@ -0,0 +1,187 @@
+//
+// Registry of the random number engines the path kernels can be instantiated with. Every engine is keyed by a
+// compile-time EngineId and exposes the same bulk interface:
+//
+//     beginBlock(block)             called before the first path of a block is generated
+//     fillPath(path, out, n)        writes the n standard normals of a path into out
+//
+// AUTO_CANDIDATE marks the engines EngineTuner may pick for --engine auto; the others are only used by name.
+// Philox is counter-based and keys each path by its index. The sequential engines are reseeded at the start of
+// every block from (seed, block), so every engine gives the same block statistics on any thread, shard or resume.
+// dispatchEngine() turns a runtime EngineId into a call of a kernel template, so the engine is resolved once per
+// run instead of once per variate.
+//
+
+#ifndef MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_ENGINEREGISTRY_HPP
+#define MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_ENGINEREGISTRY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "Philox.hpp"
+
+// Compile-time ids of the engines. They are stored in partial results and path exports, so they never change.
+enum class EngineId : unsigned int
+{
+    MERSENNE_TWISTER = 1,
+    LAGGED_FIBONACCI = 2,
+    LINEAR_CONGRUENTIAL = 3,
+    PHILOX = 5
+};
+
+// Counter-based engine, one Philox stream per path
+class PhiloxEngine
+{
+private:
+    Philox philox;
+
+public:
+    static constexpr EngineId ID = EngineId::PHILOX;
+    static constexpr const char* NAME = "philox";
+    static constexpr bool AUTO_CANDIDATE = true;
+
+    explicit PhiloxEngine(std::uint64_t seed) : philox{seed} {}
+    inline void beginBlock(std::uint64_t) {}
+    inline void fillPath(std::uint64_t path, double* out, std::size_t n) {philox.normals(path, out, n);}
+};
+
+// Sequential engine reseeded from (seed, block) at the start of every block
+template <typename Generator, EngineId Id>
+class SequentialEngine
+{
+private:
+    std::uint64_t seed;
+    Generator generator;
+    std::normal_distribution<double> nor{0.0, 1.0};
+
+public:
+    static constexpr EngineId ID = Id;
+    static constexpr bool AUTO_CANDIDATE = true;
+
+    explicit SequentialEngine(std::uint64_t _seed) : seed{_seed} {}
+
+    inline void beginBlock(std::uint64_t block)
+    {
+        std::seed_seq seq{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32),
+                          static_cast<std::uint32_t>(block), static_cast<std::uint32_t>(block >> 32)};
+        generator.seed(seq);
+        nor.reset();
+    }
+
+    inline void fillPath(std::uint64_t, double* out, std::size_t n)
+    {
+        for (std::size_t i = 0; i < n; ++i) out[i] = nor(generator);
+    }
+};
+
+class MersenneTwisterEngine : public SequentialEngine<std::mt19937_64, EngineId::MERSENNE_TWISTER>
+{
+public:
+    static constexpr const char* NAME = "mersenne-twister";
+    using SequentialEngine::SequentialEngine;
+};
+
+class LaggedFibonacciEngine : public SequentialEngine<std::ranlux24_base, EngineId::LAGGED_FIBONACCI>
+{
+public:
+    static constexpr const char* NAME = "lagged-fibonacci";
+    using SequentialEngine::SequentialEngine;
+};
+
+class LinearCongruentialEngine : public SequentialEngine<std::minstd_rand, EngineId::LINEAR_CONGRUENTIAL>
+{
+public:
+    static constexpr const char* NAME = "linear-congruential";
+    static constexpr bool AUTO_CANDIDATE = false;   // 31 bits of state, only available by name
+    using SequentialEngine::SequentialEngine;
+};
+
+// The registered engines, in order of preference when several are equally fast
+template <typename... Engines>
+struct EngineList {};
+
+using RegisteredEngines = EngineList<PhiloxEngine, MersenneTwisterEngine, LaggedFibonacciEngine,
+                                     LinearCongruentialEngine>;
+
+/**
+ * Calls kernel(std::type_identity<Engine>{}) for the registered engine whose id matches
+ * @param id Runtime id of the engine
+ * @param kernel Generic callable that is instantiated once per registered engine
+ * @throws std::invalid_argument if no engine is registered under the id
+ */
+template <typename Kernel, typename... Engines>
+void dispatchEngine(EngineList<Engines...>, EngineId id, Kernel&& kernel)
+{
+    bool found = ((id == Engines::ID ? (kernel(std::type_identity<Engines>{}), true) : false) || ...);
+    if (!found)
+    {
+        throw std::invalid_argument("No engine registered under id " + std::to_string(static_cast<unsigned int>(id)));
+    }
+}
+
+template <typename Kernel>
+void dispatchEngine(EngineId id, Kernel&& kernel)
+{
+    dispatchEngine(RegisteredEngines{}, id, std::forward<Kernel>(kernel));
+}
+
+/**
+ * Calls visitor(std::type_identity<Engine>{}) for every registered engine, in registration order
+ * @param visitor Generic callable that is instantiated once per registered engine
+ */
+template <typename Visitor, typename... Engines>
+void forEachEngine(EngineList<Engines...>, Visitor&& visitor)
+{
+    (visitor(std::type_identity<Engines>{}), ...);
+}
+
+template <typename Visitor>
+void forEachEngine(Visitor&& visitor)
+{
+    forEachEngine(RegisteredEngines{}, std::forward<Visitor>(visitor));
+}
+
+/**
+ * Looks up a registered engine by its name, e.g. "philox" or "mersenne-twister"
+ * @param name Name of the engine
+ * @return The id of the engine
+ * @throws std::invalid_argument if no engine is registered under the name
+ */
+inline EngineId getEngineIdFromName(const std::string& name)
+{
+    EngineId id{};
+    bool found = false;
+    forEachEngine([&](auto engine)
+    {
+        using Engine = typename decltype(engine)::type;
+        if (name == Engine::NAME)
+        {
+            id = Engine::ID;
+            found = true;
+        }
+    });
+    if (!found) throw std::invalid_argument("Unknown engine " + name);
+
+    return id;
+}
+
+/**
+ * Looks up the name of a registered engine
+ * @param id Id of the engine
+ * @return The name of the engine
+ */
+inline std::string getEngineName(EngineId id)
+{
+    std::string name;
+    dispatchEngine(id, [&](auto engine) { name = decltype(engine)::type::NAME; });
+
+    return name;
+}
+
+
+#endif //MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_ENGINEREGISTRY_HPP
@@ -0,0 +1,204 @@
+//
+// Startup auto-tuning of the random number engine. Every engine of the EngineRegistry is run through the same
+// block/path access pattern as the path kernel, timed, and checked against quality gates on the moments of its
+// normals, their serial correlation up to lag MAX_LAG, and chi-squared tests of their uniforms Phi(x) in single
+// buckets and in buckets of consecutive pairs. The fastest AUTO_CANDIDATE engine that passes every gate is selected.
+//
+
+#include "EngineTuner.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr int REPETITIONS = 3;              // Runs per engine. The first gathers statistics, the fastest
+                                                // of the others counts.
+    constexpr unsigned long BLOCK_SIZE = 4096;  // Paths between two calls of beginBlock, as in the Pricer
+    constexpr double TOLERANCE = 5.0;           // Width of the quality gates in standard errors
+    constexpr std::size_t MAX_LAG = 8;          // Longest lag of the serial correlation gates
+    constexpr std::size_t BUCKETS = 64;         // Buckets of the uniforms in the single variate chi-squared test
+    constexpr std::size_t PAIR_BUCKETS = 16;    // Buckets per axis in the chi-squared test of consecutive pairs
+
+    // Sample statistics of the normals produced by one engine
+    struct Moments
+    {
+        double n = 0.0, sum = 0.0, sum2 = 0.0, sum3 = 0.0, sum4 = 0.0;
+        double lagN[MAX_LAG] = {}, lagSum[MAX_LAG] = {};    // Products of variates 1 to MAX_LAG apart within a path
+        double crossN = 0.0, crossSum = 0.0;                // Products of the first variates of consecutive paths
+        std::vector<double> buckets = std::vector<double>(BUCKETS);
+        std::vector<double> pairs = std::vector<double>(PAIR_BUCKETS * PAIR_BUCKETS);  // Disjoint pairs of a path
+    };
+
+    // Bucket of a normal variate under its uniform Phi(x)
+    std::size_t bucket(double x, std::size_t buckets)
+    {
+        double u = 0.5 * std::erfc(-x / std::numbers::sqrt2);
+        return std::min(buckets - 1, static_cast<std::size_t>(u * static_cast<double>(buckets)));
+    }
+
+    // Standardised chi-squared statistic of equally likely buckets, approximately N(0, 1) for a good engine
+    double chiSquared(const std::vector<double>& counts)
+    {
+        double total = 0.0;
+        for (double count : counts) total += count;
+        double expected = total / static_cast<double>(counts.size());
+        double statistic = 0.0;
+        for (double count : counts) statistic += (count - expected) * (count - expected) / expected;
+
+        double freedom = static_cast<double>(counts.size() - 1);
+        return (statistic - freedom) / std::sqrt(2.0 * freedom);
+    }
+
+    // Returns the first quality gate the sample fails, or an empty string
+    std::string failedGate(const Moments& m)
+    {
+        double mean = m.sum / m.n;
+        double variance = m.sum2 / m.n - mean * mean;
+        double skew = m.sum3 / m.n;
+        double kurtosis = m.sum4 / m.n;
+
+        if (!std::isfinite(variance)) return "non-finite variates";
+        if (std::abs(mean) > TOLERANCE / std::sqrt(m.n)) return "mean";
+        if (std::abs(variance - 1.0) > TOLERANCE * std::sqrt(2.0 / m.n)) return "variance";
+        if (std::abs(skew) > TOLERANCE * std::sqrt(6.0 / m.n)) return "skewness";
+        if (std::abs(kurtosis - 3.0) > TOLERANCE * std::sqrt(24.0 / m.n)) return "kurtosis";
+        for (std::size_t lag = 0; lag < MAX_LAG; ++lag)
+        {
+            if (m.lagN[lag] == 0.0) break;
+            if (std::abs(m.lagSum[lag] / m.lagN[lag]) > TOLERANCE / std::sqrt(m.lagN[lag]))
+            {
+                return "serial correlation at lag " + std::to_string(lag + 1);
+            }
+        }
+        if (std::abs(m.crossSum / m.crossN) > TOLERANCE / std::sqrt(m.crossN)) return "correlation between paths";
+        if (chiSquared(m.buckets) > TOLERANCE) return "uniformity";
+        if (chiSquared(m.pairs) > TOLERANCE) return "uniformity of pairs";
+
+        return "";
+    }
+}
+
+/**
+ * Overloaded ctor
+ * @param _seed Seed the engines are measured with
+ * @param _streamLength Normals per path, see Pricer::normalsPerPath
+ * @param _variates Approximate number of normals generated per engine and repetition
+ */
+EngineTuner::EngineTuner(std::uint64_t _seed, std::size_t _streamLength, std::size_t _variates)
+    : seed{_seed}, streamLength{std::max<std::size_t>(2, _streamLength)}, variates{_variates}
+{
+
+}
+
+/**
+ * Measures every registered engine
+ * @return One benchmark per engine, in registration order
+ */
+std::vector<EngineBenchmark> EngineTuner::benchmark() const
+{
+    std::vector<EngineBenchmark> benchmarks;
+    std::size_t paths = std::max<std::size_t>(2, variates / streamLength);
+    std::vector<double> path(streamLength);
+
+    forEachEngine([&](auto engine)
+    {
+        using Engine = typename decltype(engine)::type;
+
+        EngineBenchmark benchmark;
+        benchmark.id = Engine::ID;
+        benchmark.name = Engine::NAME;
+        benchmark.nanosPerVariate = std::numeric_limits<double>::infinity();
+        benchmark.candidate = Engine::AUTO_CANDIDATE;
+
+        Moments moments;
+        for (int repetition = 0; repetition < REPETITIONS; ++repetition)
+        {
+            Engine rng{seed};
+            double previousFirst = 0.0;
+            double checksum = 0.0;
+
+            auto start = std::chrono::steady_clock::now();
+            for (std::size_t p = 0; p < paths; ++p)
+            {
+                if (p % BLOCK_SIZE == 0) rng.beginBlock(p / BLOCK_SIZE);
+                rng.fillPath(p, path.data(), streamLength);
+
+                if (repetition > 0)
+                {
+                    checksum += path[0];
+                    continue;
+                }
+
+                // Statistics are gathered on the first repetition, which is left out of the timings
+                for (std::size_t i = 0; i < streamLength; ++i)
+                {
+                    double x = path[i];
+                    double x2 = x * x;
+                    moments.n += 1.0;
+                    moments.sum += x;
+                    moments.sum2 += x2;
+                    moments.sum3 += x2 * x;
+                    moments.sum4 += x2 * x2;
+                    for (std::size_t lag = 1; lag <= std::min(i, MAX_LAG); ++lag)
+                    {
+                        moments.lagN[lag - 1] += 1.0;
+                        moments.lagSum[lag - 1] += x * path[i - lag];
+                    }
+                    moments.buckets[bucket(x, BUCKETS)] += 1.0;
+                    if (i % 2 == 1)
+                    {
+                        std::size_t cell = bucket(path[i - 1], PAIR_BUCKETS) * PAIR_BUCKETS + bucket(x, PAIR_BUCKETS);
+                        moments.pairs[cell] += 1.0;
+                    }
+                }
+                if (p > 0)
+                {
+                    moments.crossN += 1.0;
+                    moments.crossSum += path[0] * previousFirst;
+                }
+                previousFirst = path[0];
+            }
+            auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+
+            // Keeps the timed repetitions from being optimised away
+            if (std::isnan(checksum)) benchmark.failure = "non-finite variates";
+            if (repetition > 0)
+            {
+                double nanos = elapsed.count() / static_cast<double>(paths * streamLength);
+                benchmark.nanosPerVariate = std::min(benchmark.nanosPerVariate, nanos);
+            }
+        }
+
+        if (benchmark.failure.empty()) benchmark.failure = failedGate(moments);
+        benchmark.passed = benchmark.failure.empty();
+        benchmarks.push_back(benchmark);
+    });
+
+    return benchmarks;
+}
+
+/**
+ * Picks the fastest candidate engine that passed every quality gate. Ties go to the engine registered first.
+ * @param benchmarks The output of benchmark()
+ * @return The id of the selected engine
+ * @throws std::runtime_error if no engine passed the quality gates
+ */
+EngineId EngineTuner::select(const std::vector<EngineBenchmark>& benchmarks)
+{
+    const EngineBenchmark* best = nullptr;
+    for (const auto& benchmark : benchmarks)
+    {
+        if (!benchmark.candidate || !benchmark.passed) continue;
+        if (!best || benchmark.nanosPerVariate < best->nanosPerVariate) best = &benchmark;
+    }
+    if (!best) throw std::runtime_error("No candidate engine passed the quality gates");
+
+    return best->id;
+}
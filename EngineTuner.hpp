@@ -0,0 +1,51 @@
+//
+// Startup auto-tuning of the random number engine. Every engine of the EngineRegistry is run through the same
+// block/path access pattern as the path kernel, timed, and checked against quality gates on the moments of its
+// normals, their serial correlation up to lag MAX_LAG, and chi-squared tests of their uniforms Phi(x) in single
+// buckets and in buckets of consecutive pairs. The fastest AUTO_CANDIDATE engine that passes every gate is selected.
+//
+
+#ifndef MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_ENGINETUNER_HPP
+#define MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_ENGINETUNER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "EngineRegistry.hpp"
+
+struct EngineBenchmark
+{
+    EngineId id{};                      // Engine that was measured
+    std::string name;                   // Name of the engine in the registry
+    double nanosPerVariate = 0.0;       // Best time per normal variate over the repetitions
+    bool candidate = false;             // True if --engine auto may select the engine
+    bool passed = false;                // True if the engine passed every quality gate
+    std::string failure;                // The first gate the engine failed, if any
+};
+
+class EngineTuner
+{
+private:
+    std::uint64_t seed;
+    std::size_t streamLength;
+    std::size_t variates;
+
+public:
+    EngineTuner(std::uint64_t _seed, std::size_t _streamLength, std::size_t _variates = 1 << 20);
+    EngineTuner(const EngineTuner& other) = default;
+    EngineTuner(EngineTuner&& other) noexcept = default;
+    virtual ~EngineTuner() = default;
+
+    // Operator Overloads
+    EngineTuner& operator=(const EngineTuner& other) = default;
+    EngineTuner& operator=(EngineTuner&& other) noexcept = default;
+
+    // Tuning API
+    std::vector<EngineBenchmark> benchmark() const;
+    static EngineId select(const std::vector<EngineBenchmark>& benchmarks);
+};
+
+
+#endif //MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_ENGINETUNER_HPP
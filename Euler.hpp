@@ -0,0 +1,78 @@
+//
+// Explicit Euler path kernel shared by the pricers. A path is simulated from a buffer of standard normals together
+// with its tangent w.r.t. the volatility, so prices and pathwise vegas come out of the same pass.
+//
+
+#ifndef MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_EULER_HPP
+#define MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_EULER_HPP
+
+#include "SDE.hpp"
+
+// State of a path after the steps simulated so far
+struct PathEnd
+{
+    double V = 0.0;                 // Value of the path
+    double dV = 0.0;                // Derivative of the value w.r.t. sig
+    unsigned long originHits = 0;   // Steps that ended at or below the origin
+};
+
+/**
+ * Advances a path with the explicit Euler method, equation (9.2) from the text, along with the tangent of each
+ * step w.r.t. sig. Drift and diffusion are linear in S.
+ * @tparam Stride Normals consumed per step. With 2, each step takes the sum of two fine increments.
+ * @param sde The SDE
+ * @param path State of the path, advanced in place
+ * @param x Time of the path, advanced in place
+ * @param increments Standard normals of the steps, at least steps * Stride of them
+ * @param steps Number of time steps
+ * @param k Size of a time step
+ * @param scale Multiplies the (summed) normals into a Brownian increment, sqrt(k / Stride)
+ */
+template <int Stride>
+inline void advance(const SDE& sde, PathEnd& path, double& x, const double* increments, long steps, double k,
+                    double scale)
+{
+    double VOld = path.V, VNew = path.V, dVOld = path.dV, dVNew = path.dV;
+    for (long index = 0; index < steps; ++index)
+    {
+        double z = increments[Stride * index];
+        if constexpr (Stride == 2) z += increments[Stride * index + 1];
+
+        VNew = VOld + (k * sde.drift(x, VOld)) + (scale * sde.diffusion(x, VOld) * z);
+        dVNew = dVOld + (k * sde.drift(x, dVOld)) + (scale * (sde.diffusion(x, dVOld) + VOld) * z);
+
+        VOld = VNew;
+        dVOld = dVNew;
+
+        if (VNew <= 0.0) path.originHits++;
+
+        x += k;
+    }
+
+    path.V = VNew;
+    path.dV = dVNew;
+}
+
+/**
+ * Simulates one path from time 0 with the explicit Euler method
+ * @tparam Stride Normals consumed per step, see advance()
+ * @param sde The SDE
+ * @param S Initial value
+ * @param increments Standard normals of the path, at least steps * Stride of them
+ * @param steps Number of time steps
+ * @param k Size of a time step
+ * @param scale Multiplies the (summed) normals into a Brownian increment, sqrt(k / Stride)
+ * @return The terminal value, its vega tangent and the number of origin hits
+ */
+template <int Stride>
+inline PathEnd euler(const SDE& sde, double S, const double* increments, long steps, double k, double scale)
+{
+    PathEnd end;
+    end.V = S;
+    double x = 0.0;
+    advance<Stride>(sde, end, x, increments, steps, k, scale);
+
+    return end;
+}
+
+#endif //MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_EULER_HPP
@@ -0,0 +1,49 @@
+// GenerateNormalPool.cpp
+//
+// Pre-generates a pool of standard normals for TestMC --normal-pool. The pool holds the Philox streams of the
+// first NSIM paths for one seed, NT variates each, so a run that reads the pool prices exactly what a run that
+// generates the variates on the fly would.
+//
+// Usage: GenerateNormalPool --out normals.pool --nsim 1000000 --nt 100 [--seed 0] [--threads 8]
+//
+
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "CommandLine.hpp"
+#include "NormalPool.hpp"
+#include "PricerOptions.hpp"
+
+int main(int argc, char* argv[])
+{
+    CommandLine commandLine(argc, argv);
+    if (!commandLine.has("out") || !commandLine.has("nsim") || !commandLine.has("nt"))
+    {
+        std::cerr << "Usage: GenerateNormalPool --out <file> --nsim <paths> --nt <steps> [--seed <n>] [--threads <n>]"
+                  << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        std::string path = commandLine.get("out", "");
+        unsigned long NSIM = commandLine.getUnsignedLong("nsim", 0);
+        unsigned long NT = commandLine.getUnsignedLong("nt", 0);
+        unsigned long seed = commandLine.getUnsignedLong("seed", 0);
+        unsigned int threads = readThreads(commandLine);
+        if (NSIM < 1 || NT < 1) throw std::invalid_argument("Expected at least one path and one normal per path");
+
+        NormalPool::generate(path, seed, NSIM, NT, threads);
+        std::cout << "Wrote " << NSIM << " paths of " << NT << " normals for seed " << seed << " to " << path
+                  << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Unable to generate normal pool - " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
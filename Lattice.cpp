@@ -0,0 +1,91 @@
+//
+// Cox-Ross-Rubinstein binomial lattice for European and American options on an asset paying a continuous dividend
+// yield. Serves the requests that have no closed form, such as American puts, much faster than a simulation.
+//
+
+#include "Lattice.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    constexpr double VEGA_BUMP = 1e-4;  // Absolute volatility bump of the central difference
+
+    // Rolls the lattice back to its root. Returns the price and the two values after the first step.
+    struct Rollback
+    {
+        double price = 0.0;
+        double up = 0.0;
+        double down = 0.0;
+    };
+
+    Rollback rollback(const OptionData& optionData, bool american, unsigned int steps, double sig)
+    {
+        double dt = optionData.T / steps;
+        double u = std::exp(sig * std::sqrt(dt));
+        double d = 1.0 / u;
+        double discount = std::exp(-optionData.r * dt);
+        double p = (std::exp((optionData.r - optionData.D) * dt) - d) / (u - d);
+        if (!(p > 0.0 && p < 1.0)) throw std::invalid_argument("Too few lattice steps for the option's parameters");
+
+        // Payoffs at expiry, node i having i up moves. Node i of step n sits u above node i of step n + 1.
+        std::vector<double> spots(steps + 1);
+        std::vector<double> values(steps + 1);
+        spots[0] = optionData.S * std::pow(d, steps);
+        for (unsigned int i = 0; i <= steps; ++i)
+        {
+            if (i > 0) spots[i] = spots[i - 1] * u * u;
+            values[i] = optionData.myPayOffFunction(spots[i]);
+        }
+
+        Rollback result;
+        for (unsigned int n = steps; n-- > 0;)
+        {
+            for (unsigned int i = 0; i <= n; ++i)
+            {
+                double continuation = discount * (p * values[i + 1] + (1.0 - p) * values[i]);
+                spots[i] *= u;
+                values[i] = american ? std::max(continuation, optionData.myPayOffFunction(spots[i])) : continuation;
+            }
+            if (n == 1)
+            {
+                result.down = values[0];
+                result.up = values[1];
+            }
+        }
+        result.price = values[0];
+
+        return result;
+    }
+}
+
+/**
+ * Prices an option on a CRR binomial lattice
+ * @param optionData The option. type == 1 is a call, anything else a put.
+ * @param american True if the option may be exercised at any node
+ * @param steps Number of time steps of the lattice, at least 2
+ * @return The price, the lattice delta and the vega by central differences of two more lattices
+ * @throws std::invalid_argument if the lattice has fewer than 2 steps or its probabilities leave (0, 1)
+ */
+LatticeResult binomialLattice(const OptionData& optionData, bool american, unsigned int steps)
+{
+    if (steps < 2) throw std::invalid_argument("A lattice needs at least 2 steps");
+    if (!(optionData.T > 0.0 && optionData.sig > 0.0)) throw std::invalid_argument("A lattice needs T > 0 and sig > 0");
+
+    Rollback centre = rollback(optionData, american, steps, optionData.sig);
+    double u = std::exp(optionData.sig * std::sqrt(optionData.T / steps));
+
+    LatticeResult result;
+    result.price = centre.price;
+    result.delta = (centre.up - centre.down) / (optionData.S * (u - 1.0 / u));
+
+    double down = std::max(optionData.sig - VEGA_BUMP, 0.5 * optionData.sig);
+    double up = optionData.sig + VEGA_BUMP;
+    result.vega = (rollback(optionData, american, steps, up).price - rollback(optionData, american, steps, down).price)
+                  / (up - down);
+
+    return result;
+}
@@ -0,0 +1,21 @@
+//
+// Cox-Ross-Rubinstein binomial lattice for European and American options on an asset paying a continuous dividend
+// yield. Serves the requests that have no closed form, such as American puts, much faster than a simulation.
+//
+
+#ifndef MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_LATTICE_HPP
+#define MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_LATTICE_HPP
+
+#include "OptionData.hpp"
+
+struct LatticeResult
+{
+    double price = 0.0;                 // Discounted price
+    double delta = 0.0;                 // Derivative of the price w.r.t. spot, from the first step of the lattice
+    double vega = 0.0;                  // Derivative of the price w.r.t. volatility, by central differences
+};
+
+LatticeResult binomialLattice(const OptionData& optionData, bool american, unsigned int steps);
+
+
+#endif //MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_LATTICE_HPP
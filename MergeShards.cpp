@@ -0,0 +1,68 @@
+// MergeShards.cpp
+//
+// Combines the partial results written by TestMC --shard i/N into the estimate of a single run. The blocks of
+// every part are folded in index order, so the result is bit for bit the one an unsharded run would print.
+//
+// Usage: MergeShards [--out merged.part] shard-0-of-4.part shard-1-of-4.part ...
+//
+
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "PartialResult.hpp"
+#include "Pricer.hpp"
+
+int main(int argc, char* argv[])
+{
+    std::string out;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string argument = argv[i];
+        if (argument == "--out" && i + 1 < argc) out = argv[++i];
+        else paths.push_back(argument);
+    }
+
+    if (paths.empty())
+    {
+        std::cerr << "Usage: MergeShards [--out merged.part] <partial result>..." << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        std::vector<PartialResult> parts;
+        for (const auto& path : paths) parts.push_back(PartialResult::read(path));
+
+        PartialResult merged = PartialResult::merge(parts);
+        if (!merged.complete())
+        {
+            std::cerr << "Warning: " << merged.blocks.size() << " of " << Pricer::blockCount(merged.config)
+                      << " blocks present, the estimate covers a subset of the paths" << std::endl;
+        }
+        if (!out.empty()) merged.write(out);
+
+        PricerResult result = Pricer::summarise(merged.optionData, merged.reduce());
+
+        std::cout << "Price, after discounting: " << result.price << ", " << std::endl;
+        std::cout << "Number of times origin is hit: " << result.payoffs.originHits << std::endl;
+        std::cout << "Standard Deviation: " << result.payoffs.standardDeviation() << ", " << std::endl;
+        std::cout << "Standard Error: " << result.payoffs.standardError() << ", " << std::endl;
+        std::cout << "Delta: " << result.delta << ", " << std::endl;
+        std::cout << "Vega: " << result.vega << ", " << std::endl;
+        if (merged.config.richardson)
+        {
+            std::cout << "Estimated bias of the " << merged.config.NT << " step Euler price: " << result.bias
+                      << std::endl;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Unable to merge partial results - " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
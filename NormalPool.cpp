@@ -0,0 +1,181 @@
+//
+// Persistent pool of pre-generated standard normals. The pool is a versioned file holding the first streamLength
+// variates of each of the first streams Philox streams for a seed, so pricing from the pool gives exactly the
+// same result as generating the variates on the fly. The pool is memory-mapped read-only and shared between the
+// threads of a process, and between processes through the page cache. Workers read disjoint ranges of streams.
+//
+
+#include "NormalPool.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Philox.hpp"
+
+namespace
+{
+    constexpr char NORMAL_POOL_MAGIC[8] = {'M', 'C', 'N', 'O', 'R', 'M', 'A', 'L'};
+
+    static_assert(sizeof(NormalPoolHeader) == 64, "The variates must start on a cache line");
+
+    // Closes a file descriptor when it goes out of scope
+    struct FileDescriptor
+    {
+        int fd;
+        explicit FileDescriptor(int _fd) : fd{_fd} {}
+        ~FileDescriptor() { if (fd >= 0) ::close(fd); }
+    };
+}
+
+/**
+ * Overloaded ctor. Maps an existing pool read-only.
+ * @param _path Location of a pool written by generate()
+ */
+NormalPool::NormalPool(std::string _path) : path{std::move(_path)}
+{
+    FileDescriptor file{::open(path.c_str(), O_RDONLY)};
+    if (file.fd < 0) throw std::runtime_error("Unable to open normal pool " + path);
+
+    struct stat status{};
+    if (::fstat(file.fd, &status) != 0 || static_cast<std::size_t>(status.st_size) < sizeof(NormalPoolHeader))
+    {
+        throw std::runtime_error(path + " is too small to be a normal pool");
+    }
+
+    mappedBytes = static_cast<std::size_t>(status.st_size);
+    void* address = ::mmap(nullptr, mappedBytes, PROT_READ, MAP_SHARED, file.fd, 0);
+    if (address == MAP_FAILED) throw std::runtime_error("Unable to map normal pool " + path);
+
+    header = static_cast<const NormalPoolHeader*>(address);
+    variates = reinterpret_cast<const double*>(header + 1);
+
+    std::size_t expected = sizeof(NormalPoolHeader) + header->streams * header->streamLength * sizeof(double);
+    if (std::memcmp(header->magic, NORMAL_POOL_MAGIC, sizeof(NORMAL_POOL_MAGIC)) != 0 ||
+        header->version != VERSION || header->generator != PHILOX_GENERATOR || mappedBytes != expected)
+    {
+        ::munmap(address, mappedBytes);
+        throw std::runtime_error(path + " is not a normal pool of a supported version");
+    }
+
+    // Workers stream through their ranges front to back
+    ::madvise(address, mappedBytes, MADV_SEQUENTIAL);
+}
+
+/**
+ * Move ctor
+ * @param other Another NormalPool whose mapping will be moved into this NormalPool
+ */
+NormalPool::NormalPool(NormalPool&& other) noexcept
+    : path{std::move(other.path)}, header{other.header}, variates{other.variates}, mappedBytes{other.mappedBytes}
+{
+    other.header = nullptr;
+    other.variates = nullptr;
+    other.mappedBytes = 0;
+}
+
+/**
+ * Move assignment
+ * @param other Another NormalPool whose mapping will be moved into this NormalPool
+ * @return This NormalPool
+ */
+NormalPool& NormalPool::operator=(NormalPool&& other) noexcept
+{
+    if (this == &other) return *this;
+
+    if (header) ::munmap(const_cast<NormalPoolHeader*>(header), mappedBytes);
+    path = std::move(other.path);
+    header = other.header;
+    variates = other.variates;
+    mappedBytes = other.mappedBytes;
+    other.header = nullptr;
+    other.variates = nullptr;
+    other.mappedBytes = 0;
+
+    return *this;
+}
+
+/**
+ * Dtor. Unmaps the pool.
+ */
+NormalPool::~NormalPool()
+{
+    if (header) ::munmap(const_cast<NormalPoolHeader*>(header), mappedBytes);
+}
+
+/**
+ * Writes a pool. The file is sized up front and mapped, each thread fills a disjoint range of streams, and the
+ * finished file is renamed into place so that readers never map a partially written pool.
+ * @param path Location of the pool
+ * @param seed Key of the Philox streams. Must match the seed of the runs that read the pool.
+ * @param streams Number of streams, i.e. the largest NSIM the pool can serve
+ * @param streamLength Variates per stream, i.e. the largest NT the pool can serve, or 2 NT in Richardson mode
+ * @param threads Number of threads used to generate the variates
+ * @throws std::system_error if a thread can't be started
+ */
+void NormalPool::generate(const std::string& path, std::uint64_t seed, std::uint64_t streams,
+                          std::uint64_t streamLength, unsigned int threads)
+{
+    std::string temporary = path + ".tmp";
+    std::size_t bytes = sizeof(NormalPoolHeader) + streams * streamLength * sizeof(double);
+
+    FileDescriptor file{::open(temporary.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644)};
+    if (file.fd < 0) throw std::runtime_error("Unable to create " + temporary);
+    if (::ftruncate(file.fd, static_cast<off_t>(bytes)) != 0) throw std::runtime_error("Unable to size " + temporary);
+
+    void* address = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, file.fd, 0);
+    if (address == MAP_FAILED) throw std::runtime_error("Unable to map " + temporary);
+
+    auto* header = static_cast<NormalPoolHeader*>(address);
+    std::memset(header, 0, sizeof(NormalPoolHeader));
+    std::memcpy(header->magic, NORMAL_POOL_MAGIC, sizeof(NORMAL_POOL_MAGIC));
+    header->version = VERSION;
+    header->generator = PHILOX_GENERATOR;
+    header->seed = seed;
+    header->streams = streams;
+    header->streamLength = streamLength;
+
+    auto* variates = reinterpret_cast<double*>(header + 1);
+    if (threads == 0) threads = 1;
+
+    std::vector<std::thread> workers;
+    try
+    {
+        for (unsigned int worker = 0; worker < threads; ++worker)
+        {
+            std::uint64_t first = streams * worker / threads;
+            std::uint64_t last = streams * (worker + 1) / threads;
+            workers.emplace_back([=]
+            {
+                Philox philox{seed};
+                for (std::uint64_t s = first; s < last; ++s)
+                {
+                    philox.normals(s, variates + s * streamLength, streamLength);
+                }
+            });
+        }
+    }
+    catch (...)
+    {
+        // A thread that can't be started must not leave the others joinable
+        for (auto& worker : workers) worker.join();
+        ::munmap(address, bytes);
+        throw;
+    }
+    for (auto& worker : workers) worker.join();
+
+    bool synced = ::msync(address, bytes, MS_SYNC) == 0;
+    ::munmap(address, bytes);
+    if (!synced) throw std::runtime_error("Unable to write " + temporary);
+
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) throw std::runtime_error("Unable to rename " + temporary);
+}
@@ -0,0 +1,58 @@
+//
+// Persistent pool of pre-generated standard normals. The pool is a versioned file holding the first streamLength
+// variates of each of the first streams Philox streams for a seed, so pricing from the pool gives exactly the
+// same result as generating the variates on the fly. The pool is memory-mapped read-only and shared between the
+// threads of a process, and between processes through the page cache. Workers read disjoint ranges of streams.
+//
+
+#ifndef MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_NORMALPOOL_HPP
+#define MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_NORMALPOOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// On-disk header, followed by streams * streamLength doubles in stream major order
+struct NormalPoolHeader
+{
+    char magic[8];                      // "MCNORMAL"
+    std::uint32_t version;              // Layout version of the file
+    std::uint32_t generator;            // Generator of the variates, 1 == Philox4x32-10 with Box-Muller
+    std::uint64_t seed;                 // Key of the Philox streams
+    std::uint64_t streams;              // Number of streams, one per path
+    std::uint64_t streamLength;         // Variates per stream, i.e. NT
+    std::uint64_t reserved[3];          // Pads the header to 64 bytes so the variates are cache line aligned
+};
+
+class NormalPool
+{
+private:
+    std::string path;
+    const NormalPoolHeader* header = nullptr;
+    const double* variates = nullptr;
+    std::size_t mappedBytes = 0;
+
+public:
+    static constexpr std::uint32_t VERSION = 1;
+    static constexpr std::uint32_t PHILOX_GENERATOR = 1;
+
+    explicit NormalPool(std::string _path);
+    NormalPool(const NormalPool& other) = delete;
+    NormalPool(NormalPool&& other) noexcept;
+    virtual ~NormalPool();
+
+    // Operator Overloads
+    NormalPool& operator=(const NormalPool& other) = delete;
+    NormalPool& operator=(NormalPool&& other) noexcept;
+
+    // Pool API
+    static void generate(const std::string& path, std::uint64_t seed, std::uint64_t streams,
+                         std::uint64_t streamLength, unsigned int threads);
+    inline const double* stream(std::uint64_t index) const {return variates + index * header->streamLength;}
+    inline std::uint64_t seed() const {return header->seed;}
+    inline std::uint64_t streams() const {return header->streams;}
+    inline std::uint64_t streamLength() const {return header->streamLength;}
+};
+
+
+#endif //MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_NORMALPOOL_HPP
@@ -0,0 +1,219 @@
+//
+// Prices a chain of options from shared path sets. Options are grouped by their market and model inputs (S, r, D,
+// sig; every option follows the Euler Black Scholes model), and each group simulates a single set of paths on a
+// time grid that hits every expiry of the group. Workers simulate a small chunk of paths, record the chunk's values
+// at each expiry and then evaluate every strike and type of that expiry over the whole chunk in a tight loop.
+//
+
+#include "OptionChain.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "EngineRegistry.hpp"
+#include "Euler.hpp"
+#include "SDE.hpp"
+#include "WorkerPool.hpp"
+
+/**
+ * Overloaded ctor. Groups the options and lays out the time grid of each group.
+ * @param _options The options to price. Their NSIM is ignored in favour of the config's.
+ * @param _config Discretisation, number of simulations, engine and thread placement. NT is the number of steps up
+ *                to the last expiry of a group; an option that is alone in its group is simulated on exactly the
+ *                Pricer's grid. See Pricer::standalone for the options a chain ignores.
+ * @throws std::invalid_argument if NT or NSIM is 0 or an option doesn't expire in the future
+ */
+OptionChain::OptionChain(std::vector<OptionData> _options, PricerConfig _config)
+    : options{std::move(_options)}, config{Pricer::standalone(std::move(_config))}
+{
+    Pricer::validate(config);
+    if (config.blockSize == 0) config.blockSize = 1;
+    config.richardson = false;
+
+    for (std::size_t i = 0; i < options.size(); ++i)
+    {
+        const OptionData& option = options[i];
+        if (!(option.T > 0.0)) throw std::invalid_argument("Options of a chain must expire in the future");
+
+        auto same = [this, &option](const Group& group)
+        {
+            const OptionData& first = options[group.members.front()];
+            return first.S == option.S && first.r == option.r && first.D == option.D && first.sig == option.sig;
+        };
+        auto group = std::find_if(groups.begin(), groups.end(), same);
+        if (group == groups.end()) group = groups.insert(groups.end(), Group{});
+        group->members.push_back(i);
+    }
+
+    for (auto& group : groups)
+    {
+        std::stable_sort(group.members.begin(), group.members.end(),
+                         [this](std::size_t a, std::size_t b) { return options[a].T < options[b].T; });
+        for (std::size_t member : group.members)
+        {
+            if (group.expiries.empty() || group.expiries.back() != options[member].T)
+            {
+                group.expiries.push_back(options[member].T);
+            }
+            group.expiryOf.push_back(group.expiries.size() - 1);
+        }
+
+        // Steps of about T_max / NT, rounded up per segment so every expiry lies on the grid
+        double last = group.expiries.back();
+        double previous = 0.0;
+        for (double expiry : group.expiries)
+        {
+            double share = static_cast<double>(config.NT) * (expiry - previous) / last;
+            long steps = std::max(1L, static_cast<long>(std::ceil(share - 1e-9)));
+            group.steps.push_back(steps);
+            group.totalSteps += steps;
+            previous = expiry;
+        }
+    }
+}
+
+/**
+ * Prices every option. Each member of a group keeps its statistics per block, and the blocks are folded in block
+ * order, so the result doesn't depend on the number of threads.
+ * @return One result per option, in the order the options were given
+ */
+std::vector<ChainResult> OptionChain::price() const
+{
+    std::vector<ChainResult> chain;
+    chain.reserve(options.size());
+    for (const auto& option : options) chain.push_back(ChainResult{option, Accumulator{}});
+
+    unsigned long blocks = Pricer::blockCount(config);
+    WorkerPool pool(config, topology);
+
+    for (const auto& group : groups)
+    {
+        BlockStatistics statistics(pool.size(), group.members.size());
+        dispatchEngine(config.engine, [&](auto engine)
+        {
+            using Engine = typename decltype(engine)::type;
+            pool.run(blocks, [&](unsigned int worker, std::size_t first, std::size_t last)
+                     { runWorker<Engine>(group, first, last, statistics.allocate(worker, last - first)); });
+        });
+
+        std::vector<Accumulator> members = statistics.reduce();
+        for (std::size_t m = 0; m < group.members.size(); ++m)
+        {
+            ChainResult& result = chain[group.members[m]];
+            result.payoffs = members[m];
+
+            double discount = std::exp(-result.optionData.r * result.optionData.T);
+            result.price = discount * result.payoffs.mean;
+            result.delta = discount * result.payoffs.deltaMean;
+            result.vega = discount * result.payoffs.vegaMean;
+        }
+    }
+
+    return chain;
+}
+
+/**
+ * Simulates the range of blocks that belongs to one worker for one group and evaluates every member's payoff.
+ * Instantiated once per registered engine.
+ * @param group The group of options
+ * @param firstBlock The first block of the worker
+ * @param lastBlock One past the last block of the worker
+ * @param blocks Receives the statistics of each member of the group, per block of the worker
+ */
+template <typename Engine>
+void OptionChain::runWorker(const Group& group, unsigned long firstBlock, unsigned long lastBlock,
+                            std::vector<Accumulator>& blocks) const
+{
+    const OptionData& market = options[group.members.front()];
+    SDE sde(market);
+    std::size_t expiries = group.expiries.size();
+
+    // Step sizes of the segments between consecutive expiries
+    std::vector<double> k(expiries), scale(expiries);
+    double previous = 0.0;
+    for (std::size_t e = 0; e < expiries; ++e)
+    {
+        k[e] = (group.expiries[e] - previous) / static_cast<double>(group.steps[e]);
+        scale[e] = std::sqrt(k[e]);
+        previous = group.expiries[e];
+    }
+
+    std::vector<double> normals(static_cast<std::size_t>(group.totalSteps));
+    std::vector<double> V(expiries * CHUNK_SIZE);           // Values of the chunk at each expiry, expiry major
+    std::vector<double> dV(expiries * CHUNK_SIZE);          // Their vega tangents
+    std::vector<unsigned long> hits(expiries);              // Origin hits of the chunk up to each expiry
+    std::vector<double> payoff(CHUNK_SIZE);
+
+    Engine rng{config.seed};
+    for (unsigned long b = firstBlock; b < lastBlock; ++b)
+    {
+        rng.beginBlock(b);
+        Accumulator* results = blocks.data() + (b - firstBlock) * group.members.size();
+
+        unsigned long lastPath = std::min(config.NSIM, (b + 1) * config.blockSize);
+        for (unsigned long chunk = b * config.blockSize; chunk < lastPath; chunk += CHUNK_SIZE)
+        {
+            std::size_t paths = static_cast<std::size_t>(std::min<unsigned long>(CHUNK_SIZE, lastPath - chunk));
+            std::fill(hits.begin(), hits.end(), 0ul);
+
+            // One path set for the whole group, observed at every expiry
+            for (std::size_t p = 0; p < paths; ++p)
+            {
+                rng.fillPath(chunk + p, normals.data(), normals.size());
+
+                PathEnd path;
+                path.V = market.S;
+                double x = 0.0;
+                const double* increments = normals.data();
+                for (std::size_t e = 0; e < expiries; ++e)
+                {
+                    advance<1>(sde, path, x, increments, group.steps[e], k[e], scale[e]);
+                    increments += group.steps[e];
+                    V[e * CHUNK_SIZE + p] = path.V;
+                    dV[e * CHUNK_SIZE + p] = path.dV;
+                    hits[e] += path.originHits;
+                    path.originHits = 0;
+                }
+            }
+            for (std::size_t e = 1; e < expiries; ++e) hits[e] += hits[e - 1];
+
+            // Every strike and type of an expiry over the whole chunk
+            for (std::size_t m = 0; m < group.members.size(); ++m)
+            {
+                const OptionData& option = options[group.members[m]];
+                std::size_t e = group.expiryOf[m];
+                const double* values = V.data() + e * CHUNK_SIZE;
+                const double* tangents = dV.data() + e * CHUNK_SIZE;
+                double sign = option.type == 1 ? 1.0 : -1.0;
+
+                double sum = 0.0, deltaSum = 0.0, vegaSum = 0.0;
+                for (std::size_t p = 0; p < paths; ++p)
+                {
+                    double moneyness = sign * (values[p] - option.K);
+                    double slope = moneyness > 0.0 ? sign : 0.0;
+                    payoff[p] = moneyness > 0.0 ? moneyness : 0.0;
+                    sum += payoff[p];
+                    deltaSum += slope * values[p];
+                    vegaSum += slope * tangents[p];
+                }
+
+                double n = static_cast<double>(paths);
+                double mean = sum / n;
+                double M2 = 0.0;
+                for (std::size_t p = 0; p < paths; ++p) M2 += (payoff[p] - mean) * (payoff[p] - mean);
+
+                Accumulator statistics;
+                statistics.count = paths;
+                statistics.mean = mean;
+                statistics.M2 = M2;
+                statistics.originHits = hits[e];
+                statistics.deltaMean = deltaSum / (n * option.S);
+                statistics.vegaMean = vegaSum / n;
+                results[m].merge(statistics);
+            }
+        }
+    }
+}
@@ -0,0 +1,68 @@
+//
+// Prices a chain of options from shared path sets. Options are grouped by their market and model inputs (S, r, D,
+// sig; every option follows the Euler Black Scholes model), and each group simulates a single set of paths on a
+// time grid that hits every expiry of the group. Workers simulate a small chunk of paths, record the chunk's values
+// at each expiry and then evaluate every strike and type of that expiry over the whole chunk in a tight loop.
+//
+
+#ifndef MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_OPTIONCHAIN_HPP
+#define MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_OPTIONCHAIN_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "Accumulator.hpp"
+#include "OptionData.hpp"
+#include "Pricer.hpp"
+#include "Topology.hpp"
+
+struct ChainResult
+{
+    OptionData optionData;              // The option that was priced
+    Accumulator payoffs;                // Statistics of the undiscounted payoffs
+    double price = 0.0;                 // Discounted price
+    double delta = 0.0;                 // Pathwise delta
+    double vega = 0.0;                  // Pathwise vega
+};
+
+class OptionChain
+{
+private:
+    static constexpr std::size_t CHUNK_SIZE = 64;   // Paths whose expiry values are evaluated together
+
+    // Options sharing S, r, D and sig, simulated on one path set
+    struct Group
+    {
+        std::vector<std::size_t> members;   // Indices of the options, sorted by expiry
+        std::vector<std::size_t> expiryOf;  // Index into expiries of each member
+        std::vector<double> expiries;       // Distinct expiries, ascending
+        std::vector<long> steps;            // Time steps between consecutive expiries
+        long totalSteps = 0;                // Normals per path
+    };
+
+    std::vector<OptionData> options;
+    PricerConfig config;
+    std::vector<Group> groups;
+    Topology topology;
+
+    template <typename Engine>
+    void runWorker(const Group& group, unsigned long firstBlock, unsigned long lastBlock,
+                   std::vector<Accumulator>& blocks) const;
+
+public:
+    OptionChain(std::vector<OptionData> _options, PricerConfig _config);
+    OptionChain(const OptionChain& other) = default;
+    OptionChain(OptionChain&& other) noexcept = default;
+    virtual ~OptionChain() = default;
+
+    // Operator Overloads
+    OptionChain& operator=(const OptionChain& other) = default;
+    OptionChain& operator=(OptionChain&& other) noexcept = default;
+
+    // Pricing API
+    std::vector<ChainResult> price() const;
+    inline std::size_t groupCount() const {return groups.size();}
+};
+
+
+#endif //MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_OPTIONCHAIN_HPP
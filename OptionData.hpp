@@ -78,6 +78,21 @@ struct OptionData
 			return std::max (K - S, 0.0);
 		}
 	}
+
+	double myPayOffDerivative(double S) const
+	{ // Derivative of the payoff function w.r.t. S, used by pathwise greeks
+
+		if (type == 1)
+		{
+            // Call
+			return S > K ? 1.0 : 0.0;
+		}
+		else
+		{
+            // Put
+			return S < K ? -1.0 : 0.0;
+		}
+	}
 };
 
 
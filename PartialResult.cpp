@@ -0,0 +1,200 @@
+//
+// Partial accumulator state of a sharded run. The path space is cut into fixed size blocks and each shard prices a
+// contiguous range of them. A partial result keeps one Accumulator per block, so any set of partial results can be
+// merged by folding the blocks in index order, which reproduces a single run bit for bit. Doubles are written as
+// hex floats to make the files exact while keeping them human readable.
+//
+
+#include "PartialResult.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <ios>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    constexpr const char* PARTIAL_RESULT_MAGIC = "mcpartial";
+    constexpr int PARTIAL_RESULT_VERSION = 3;
+
+    // Reads a double written by std::hexfloat. Stream extraction of hex floats isn't portable, strtod is.
+    double readDouble(std::istream& in)
+    {
+        std::string token;
+        if (!(in >> token)) throw std::runtime_error("Unexpected end of partial result");
+        return std::strtod(token.c_str(), nullptr);
+    }
+
+    template <typename T>
+    T readValue(std::istream& in)
+    {
+        T value;
+        if (!(in >> value)) throw std::runtime_error("Unexpected end of partial result");
+        return value;
+    }
+}
+
+/**
+ * Overloaded ctor
+ * @param _optionData The option that was priced
+ * @param _config Discretisation, seed and shard of the run
+ * @param _blocks Per block statistics
+ */
+PartialResult::PartialResult(const OptionData& _optionData, PricerConfig _config, std::vector<BlockResult> _blocks)
+    : optionData{_optionData}, config{std::move(_config)}, blocks{std::move(_blocks)}
+{
+    std::sort(blocks.begin(), blocks.end(),
+              [](const BlockResult& a, const BlockResult& b) { return a.index < b.index; });
+}
+
+/**
+ * Writes the partial result. The file is written next to its destination and renamed into place, so readers
+ * never observe a partially written file.
+ * @param path Location of the file
+ */
+void PartialResult::write(const std::string& path) const
+{
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream out{temporary, std::ios::trunc};
+        if (!out) throw std::runtime_error("Unable to open " + temporary);
+
+        out << std::hexfloat;
+        out << PARTIAL_RESULT_MAGIC << ' ' << PARTIAL_RESULT_VERSION << '\n';
+        out << optionData.K << ' ' << optionData.T << ' ' << optionData.r << ' ' << optionData.sig << ' '
+            << optionData.S << ' ' << optionData.D << ' ' << optionData.type << '\n';
+        out << config.NT << ' ' << config.NSIM << ' ' << config.blockSize << ' '
+            << static_cast<unsigned int>(config.engine) << ' ' << config.seed << ' '
+            << config.shard << ' ' << config.shards << ' ' << config.richardson << '\n';
+        out << blocks.size() << '\n';
+        for (const auto& block : blocks)
+        {
+            const Accumulator& a = block.payoffs;
+            out << block.index << ' ' << a.count << ' ' << a.mean << ' ' << a.M2 << ' ' << a.originHits << ' '
+                << a.deltaMean << ' ' << a.vegaMean << ' ' << a.biasMean << '\n';
+        }
+
+        if (!out.flush()) throw std::runtime_error("Unable to write " + temporary);
+    }
+
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) throw std::runtime_error("Unable to rename " + temporary);
+}
+
+/**
+ * Reads a partial result written by write()
+ * @param path Location of the file
+ * @return The partial result
+ */
+PartialResult PartialResult::read(const std::string& path)
+{
+    std::ifstream in{path};
+    if (!in) throw std::runtime_error("Unable to open " + path);
+
+    if (readValue<std::string>(in) != PARTIAL_RESULT_MAGIC || readValue<int>(in) != PARTIAL_RESULT_VERSION)
+    {
+        throw std::runtime_error(path + " is not a partial result of a supported version");
+    }
+
+    double K = readDouble(in), T = readDouble(in), r = readDouble(in), sig = readDouble(in), S = readDouble(in);
+    double D = readDouble(in);
+    int type = readValue<int>(in);
+
+    PricerConfig config;
+    config.NT = readValue<long>(in);
+    config.NSIM = readValue<unsigned long>(in);
+    config.blockSize = readValue<unsigned long>(in);
+    config.engine = static_cast<EngineId>(readValue<unsigned int>(in));
+    config.seed = readValue<unsigned long>(in);
+    config.shard = readValue<unsigned int>(in);
+    config.shards = readValue<unsigned int>(in);
+    config.richardson = readValue<bool>(in);
+
+    std::vector<BlockResult> blocks(readValue<std::size_t>(in));
+    for (auto& block : blocks)
+    {
+        Accumulator& a = block.payoffs;
+        block.index = readValue<unsigned long>(in);
+        a.count = readValue<unsigned long>(in);
+        a.mean = readDouble(in);
+        a.M2 = readDouble(in);
+        a.originHits = readValue<unsigned long>(in);
+        a.deltaMean = readDouble(in);
+        a.vegaMean = readDouble(in);
+        a.biasMean = readDouble(in);
+    }
+
+    return PartialResult{OptionData{K, T, r, sig, S, config.NSIM, D, type}, config, std::move(blocks)};
+}
+
+/**
+ * Combines partial results of the same run
+ * @param parts Partial results over disjoint sets of blocks
+ * @return A partial result that holds the blocks of every part
+ */
+PartialResult PartialResult::merge(const std::vector<PartialResult>& parts)
+{
+    if (parts.empty()) throw std::invalid_argument("No partial results to merge");
+
+    std::vector<BlockResult> blocks;
+    for (const auto& part : parts)
+    {
+        if (!parts.front().samePathSpace(part)) throw std::invalid_argument("Partial results are from different runs");
+        blocks.insert(blocks.end(), part.blocks.begin(), part.blocks.end());
+    }
+
+    PricerConfig config = parts.front().config;
+    config.shard = 0;
+    config.shards = 1;
+    PartialResult merged{parts.front().optionData, config, std::move(blocks)};
+
+    auto duplicate = std::adjacent_find(merged.blocks.begin(), merged.blocks.end(),
+                                        [](const BlockResult& a, const BlockResult& b) { return a.index == b.index; });
+    if (duplicate != merged.blocks.end())
+    {
+        throw std::invalid_argument("Block " + std::to_string(duplicate->index) + " appears in more than one part");
+    }
+
+    return merged;
+}
+
+/**
+ * Folds the blocks in index order, which is the order a single run reduces them in
+ * @return The statistics of every path in the partial result
+ */
+Accumulator PartialResult::reduce() const
+{
+    Accumulator payoffs;
+    for (const auto& block : blocks) payoffs.merge(block.payoffs);
+
+    return payoffs;
+}
+
+/**
+ * Checks whether the partial result covers the whole path space
+ * @return True if every block is present. False otherwise.
+ */
+bool PartialResult::complete() const
+{
+    return blocks.size() == Pricer::blockCount(config);
+}
+
+/**
+ * Two partial results can only be merged if they priced the same option on the same path space
+ * @param other Another partial result
+ * @return True if both describe the same option, discretisation, scheme, number of paths, block size, engine and
+ *         seed
+ */
+bool PartialResult::samePathSpace(const PartialResult& other) const
+{
+    const OptionData& x = optionData;
+    const OptionData& y = other.optionData;
+    return x.K == y.K && x.T == y.T && x.r == y.r && x.sig == y.sig && x.S == y.S && x.D == y.D &&
+           x.type == y.type && config.NT == other.config.NT && config.NSIM == other.config.NSIM &&
+           config.blockSize == other.config.blockSize && config.engine == other.config.engine &&
+           config.seed == other.config.seed && config.richardson == other.config.richardson;
+}
@@ -0,0 +1,38 @@
+//
+// Partial accumulator state of a sharded run. The path space is cut into fixed size blocks and each shard prices a
+// contiguous range of them. A partial result keeps one Accumulator per block, so any set of partial results can be
+// merged by folding the blocks in index order, which reproduces a single run bit for bit. Doubles are written as
+// hex floats to make the files exact while keeping them human readable.
+//
+
+#ifndef MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_PARTIALRESULT_HPP
+#define MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_PARTIALRESULT_HPP
+
+#include <string>
+#include <vector>
+
+#include "Accumulator.hpp"
+#include "OptionData.hpp"
+#include "Pricer.hpp"
+
+struct PartialResult
+{
+    OptionData optionData;              // The option that was priced
+    PricerConfig config;                // Discretisation, seed and shard of the run
+    std::vector<BlockResult> blocks;    // Per block statistics, sorted by block index
+
+    PartialResult(const OptionData& _optionData, PricerConfig _config, std::vector<BlockResult> _blocks);
+
+    // Persistence
+    void write(const std::string& path) const;
+    static PartialResult read(const std::string& path);
+
+    // Reduction
+    static PartialResult merge(const std::vector<PartialResult>& parts);
+    Accumulator reduce() const;
+    bool complete() const;
+    bool samePathSpace(const PartialResult& other) const;
+};
+
+
+#endif //MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_PARTIALRESULT_HPP
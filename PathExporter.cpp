@@ -0,0 +1,190 @@
+//
+// Streams the terminal values and payoffs of every simulated path to a compact binary file from a background
+// thread. Each worker owns a lane of two buffers: it fills one with a block of paths while the writer drains the
+// other, so a worker only waits when the writer has fallen a full block behind. Blocks are written in the order
+// they are finished; the block index of each record gives the path indices.
+//
+
+#include "PathExporter.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ios>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace
+{
+    constexpr char PATH_EXPORT_MAGIC[8] = {'M', 'C', 'P', 'A', 'T', 'H', 'E', 'X'};
+
+    static_assert(sizeof(PathExportHeader) == 64, "The header must be 64 bytes");
+}
+
+/**
+ * Overloaded ctor. Opens the file next to its destination; stop() renames it into place once every block is
+ * written, so readers never observe a partially written export.
+ * @param _path Location of the file
+ * @param engine EngineId of the run
+ * @param seed Seed of the engine
+ * @param NSIM Number of simulations of the run
+ * @param NT Number of time steps of the run
+ * @param blockSize Number of paths per block
+ * @param workers Number of workers, one lane each
+ */
+PathExporter::PathExporter(std::string _path, std::uint32_t engine, std::uint64_t seed, std::uint64_t NSIM,
+                           std::uint64_t NT, std::uint64_t blockSize, unsigned int workers)
+    : path{std::move(_path)}, lanes(workers)
+{
+    std::memcpy(header.magic, PATH_EXPORT_MAGIC, sizeof(header.magic));
+    header.version = VERSION;
+    header.engine = engine;
+    header.seed = seed;
+    header.NSIM = NSIM;
+    header.NT = NT;
+    header.blockSize = blockSize;
+
+    out.open(path + ".tmp", std::ios::binary | std::ios::trunc);
+    if (!out) throw std::runtime_error("Unable to open " + path + ".tmp");
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    metrics.bytes = sizeof(header);
+}
+
+/**
+ * Dtor. Stops the writer thread if the client didn't.
+ */
+PathExporter::~PathExporter()
+{
+    if (thread.joinable())
+    {
+        try { stop(); } catch (...) {}
+    }
+}
+
+/**
+ * Starts the writer thread
+ */
+void PathExporter::start()
+{
+    thread = std::thread{[this] { run(); }};
+}
+
+/**
+ * Writes the blocks still queued, stops the writer thread and moves the file into place
+ * @return The number of blocks and bytes written and the time the workers waited on the writer
+ * @throws std::runtime_error if the file couldn't be written
+ */
+PathExportMetrics PathExporter::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock{mtx};
+        stopping = true;
+    }
+    cv.notify_all();
+    if (thread.joinable()) thread.join();
+
+    for (const auto& lane : lanes) metrics.stallSeconds += lane.stallSeconds;
+
+    out.close();
+    if (failed || !out) throw std::runtime_error("Unable to write " + path + ".tmp");
+    if (std::rename((path + ".tmp").c_str(), path.c_str()) != 0)
+    {
+        throw std::runtime_error("Unable to rename " + path + ".tmp to " + path);
+    }
+
+    return metrics;
+}
+
+/**
+ * Hands a worker the buffer it fills next, waiting if the writer still owns it
+ * @param worker Index of the worker
+ * @param block Index of the block the worker is about to simulate
+ * @return An empty buffer with room for a block
+ */
+PathBuffer& PathExporter::acquire(unsigned int worker, unsigned long block)
+{
+    Lane& lane = lanes[worker];
+    {
+        std::unique_lock<std::mutex> lock{mtx};
+        if (lane.queued[lane.filling])
+        {
+            auto start = std::chrono::steady_clock::now();
+            cv.wait(lock, [&lane] { return !lane.queued[lane.filling]; });
+            lane.stallSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+    }
+
+    PathBuffer& buffer = lane.buffers[lane.filling];
+    buffer.block = block;
+    buffer.terminals.clear();
+    buffer.payoffs.clear();
+    buffer.terminals.reserve(header.blockSize);
+    buffer.payoffs.reserve(header.blockSize);
+
+    return buffer;
+}
+
+/**
+ * Queues the buffer returned by the last acquire() for writing and switches the worker to its other buffer
+ * @param worker Index of the worker
+ */
+void PathExporter::submit(unsigned int worker)
+{
+    Lane& lane = lanes[worker];
+    {
+        std::lock_guard<std::mutex> lock{mtx};
+        lane.queued[lane.filling] = true;
+        queue.emplace_back(worker, lane.filling);
+    }
+    cv.notify_all();
+    lane.filling = 1 - lane.filling;
+}
+
+/**
+ * Writes queued buffers until stopped and the queue is empty
+ */
+void PathExporter::run()
+{
+    std::unique_lock<std::mutex> lock{mtx};
+    while (true)
+    {
+        cv.wait(lock, [this] { return stopping || !queue.empty(); });
+        if (queue.empty()) break;
+
+        auto [worker, index] = queue.front();
+        queue.pop_front();
+        lock.unlock();
+
+        write(lanes[worker].buffers[index]);
+
+        lock.lock();
+        lanes[worker].queued[index] = false;
+        cv.notify_all();
+    }
+}
+
+/**
+ * Appends one record. After a failed write the remaining records are dropped, so workers never wait on a broken
+ * file; stop() reports the failure.
+ * @param buffer The block to write
+ */
+void PathExporter::write(const PathBuffer& buffer)
+{
+    if (failed) return;
+
+    PathExportRecord record{buffer.block, buffer.terminals.size()};
+    std::streamsize values = static_cast<std::streamsize>(record.count * sizeof(double));
+    out.write(reinterpret_cast<const char*>(&record), sizeof(record));
+    out.write(reinterpret_cast<const char*>(buffer.terminals.data()), values);
+    out.write(reinterpret_cast<const char*>(buffer.payoffs.data()), values);
+
+    if (!out)
+    {
+        failed = true;
+        return;
+    }
+    metrics.blocks++;
+    metrics.bytes += sizeof(record) + 2 * static_cast<std::size_t>(values);
+}
@@ -0,0 +1,107 @@
+//
+// Streams the terminal values and payoffs of every simulated path to a compact binary file from a background
+// thread. Each worker owns a lane of two buffers: it fills one with a block of paths while the writer drains the
+// other, so a worker only waits when the writer has fallen a full block behind. Blocks are written in the order
+// they are finished; the block index of each record gives the path indices.
+//
+
+#ifndef MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_PATHEXPORTER_HPP
+#define MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_PATHEXPORTER_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// On-disk header. Each record that follows is a PathExportRecord, then count terminal values, then count payoffs,
+// all doubles. Path i of a record is path block * blockSize + i of the run.
+struct PathExportHeader
+{
+    char magic[8];                      // "MCPATHEX"
+    std::uint32_t version;              // Layout version of the file
+    std::uint32_t engine;               // EngineId of the run
+    std::uint64_t seed;                 // Seed of the engine
+    std::uint64_t NSIM;                 // Number of simulations of the run
+    std::uint64_t NT;                   // Number of time steps of the run
+    std::uint64_t blockSize;            // Number of paths per block
+    std::uint64_t reserved[2];          // Pads the header to 64 bytes
+};
+
+struct PathExportRecord
+{
+    std::uint64_t block;                // Index of the block
+    std::uint64_t count;                // Number of paths in the record
+};
+
+// One block of paths on its way to the file
+struct PathBuffer
+{
+    unsigned long block = 0;
+    std::vector<double> terminals;
+    std::vector<double> payoffs;
+};
+
+struct PathExportMetrics
+{
+    unsigned long blocks = 0;           // Number of blocks written
+    std::size_t bytes = 0;              // Size of the file
+    double stallSeconds = 0.0;          // Time workers spent waiting for a free buffer, summed over the workers
+};
+
+class PathExporter
+{
+private:
+    struct alignas(64) Lane
+    {
+        PathBuffer buffers[2];
+        bool queued[2] = {false, false};    // Guarded by mtx. True while the writer owns the buffer.
+        int filling = 0;                    // Buffer the worker fills next. Only touched by the worker.
+        double stallSeconds = 0.0;          // Only touched by the worker
+    };
+
+    std::string path;
+    PathExportHeader header{};
+    std::vector<Lane> lanes;
+    std::ofstream out;
+    PathExportMetrics metrics;
+    bool failed = false;
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::deque<std::pair<unsigned int, int>> queue;     // (lane, buffer) pairs waiting to be written
+    bool stopping = false;
+    std::thread thread;
+
+    void write(const PathBuffer& buffer);
+    void run();
+
+public:
+    static constexpr std::uint32_t VERSION = 1;
+
+    PathExporter(std::string _path, std::uint32_t engine, std::uint64_t seed, std::uint64_t NSIM, std::uint64_t NT,
+                 std::uint64_t blockSize, unsigned int workers);
+    PathExporter(const PathExporter& other) = delete;
+    PathExporter(PathExporter&& other) noexcept = delete;
+    virtual ~PathExporter();
+
+    // Operator Overloads
+    PathExporter& operator=(const PathExporter& other) = delete;
+    PathExporter& operator=(PathExporter&& other) noexcept = delete;
+
+    // Lifecycle
+    void start();
+    PathExportMetrics stop();
+
+    // Worker API
+    PathBuffer& acquire(unsigned int worker, unsigned long block);
+    void submit(unsigned int worker);
+};
+
+
+#endif //MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_PATHEXPORTER_HPP
@@ -0,0 +1,82 @@
+//
+// Counter-based random number generator (Philox4x32-10, Salmon et al. 2011). Every variate is a pure function of
+// the key and a counter, so any stream can be positioned without generating the variates in front of it. The
+// pricer uses one stream per path, which keeps shards, threads and resumed runs from ever overlapping.
+//
+
+#include "Philox.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+namespace
+{
+    constexpr std::uint32_t PHILOX_M0 = 0xD2511F53;
+    constexpr std::uint32_t PHILOX_M1 = 0xCD9E8D57;
+    constexpr std::uint32_t PHILOX_W0 = 0x9E3779B9;
+    constexpr std::uint32_t PHILOX_W1 = 0xBB67AE85;
+    constexpr double TWO_PI = 6.283185307179586476925286766559;
+
+    // Maps 64 random bits onto the open interval (0, 1) with 53 bits of precision
+    inline double toUniform(std::uint32_t lo, std::uint32_t hi)
+    {
+        std::uint64_t bits = (static_cast<std::uint64_t>(hi) << 32 | lo) >> 11;
+        return (static_cast<double>(bits) + 0.5) * 0x1.0p-53;
+    }
+}
+
+/**
+ * Overloaded ctor
+ * @param seed The key of the generator. Different seeds give statistically independent families of streams.
+ */
+Philox::Philox(std::uint64_t seed) : key{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)}
+{
+
+}
+
+/**
+ * Applies the ten Philox rounds to a counter
+ * @param counter The 128 bit counter
+ * @return 128 random bits
+ */
+std::array<std::uint32_t, 4> Philox::operator()(std::array<std::uint32_t, 4> counter) const
+{
+    std::array<std::uint32_t, 2> k = key;
+    for (int round = 0; round < 10; ++round)
+    {
+        std::uint64_t p0 = static_cast<std::uint64_t>(PHILOX_M0) * counter[0];
+        std::uint64_t p1 = static_cast<std::uint64_t>(PHILOX_M1) * counter[2];
+        counter = {static_cast<std::uint32_t>(p1 >> 32) ^ counter[1] ^ k[0], static_cast<std::uint32_t>(p1),
+                   static_cast<std::uint32_t>(p0 >> 32) ^ counter[3] ^ k[1], static_cast<std::uint32_t>(p0)};
+        k[0] += PHILOX_W0;
+        k[1] += PHILOX_W1;
+    }
+
+    return counter;
+}
+
+/**
+ * Fills a buffer with the first n standard normal variates of a stream using the Box-Muller transform. Each
+ * counter produces one pair of variates.
+ * @param stream Index of the stream, e.g. the index of a path
+ * @param out Buffer that receives the variates
+ * @param n Number of variates
+ */
+void Philox::normals(std::uint64_t stream, double* out, std::size_t n) const
+{
+    for (std::size_t i = 0; i < n; i += 2)
+    {
+        std::uint64_t pair = i / 2;
+        std::array<std::uint32_t, 4> bits = (*this)({static_cast<std::uint32_t>(pair),
+                                                     static_cast<std::uint32_t>(pair >> 32),
+                                                     static_cast<std::uint32_t>(stream),
+                                                     static_cast<std::uint32_t>(stream >> 32)});
+
+        double radius = std::sqrt(-2.0 * std::log(toUniform(bits[0], bits[1])));
+        double angle = TWO_PI * toUniform(bits[2], bits[3]);
+
+        out[i] = radius * std::cos(angle);
+        if (i + 1 < n) out[i + 1] = radius * std::sin(angle);
+    }
+}
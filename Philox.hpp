@@ -0,0 +1,35 @@
+//
+// Counter-based random number generator (Philox4x32-10, Salmon et al. 2011). Every variate is a pure function of
+// the key and a counter, so any stream can be positioned without generating the variates in front of it. The
+// pricer uses one stream per path, which keeps shards, threads and resumed runs from ever overlapping.
+//
+
+#ifndef MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_PHILOX_HPP
+#define MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_PHILOX_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+class Philox
+{
+private:
+    std::array<std::uint32_t, 2> key;
+
+public:
+    explicit Philox(std::uint64_t seed = 0);
+    Philox(const Philox& other) = default;
+    Philox(Philox&& other) noexcept = default;
+    virtual ~Philox() = default;
+
+    // Operator Overloads
+    Philox& operator=(const Philox& other) = default;
+    Philox& operator=(Philox&& other) noexcept = default;
+
+    // Generator API
+    std::array<std::uint32_t, 4> operator()(std::array<std::uint32_t, 4> counter) const;
+    void normals(std::uint64_t stream, double* out, std::size_t n) const;
+};
+
+
+#endif //MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_PHILOX_HPP
@@ -0,0 +1,86 @@
+// PriceChain.cpp
+//
+// Prices a chain of options from shared path sets. Reads one option per line as "K,T,r,sig,S,D,type" (type 1 ==
+// call, -1 == put); blank lines, lines starting with '#' and a header line are skipped. Options with the same S, r, D
+// and sig are priced from one set of paths observed at each of their expiries.
+//
+// Usage: PriceChain --options chain.csv [--nt 100] [--nsim 50000] [--threads n] [--engine philox|auto] [--seed n]
+//                   [--pin policy] [--block-size n]
+//
+
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "BlackScholes.hpp"
+#include "CommandLine.hpp"
+#include "CsvFile.hpp"
+#include "OptionChain.hpp"
+#include "OptionData.hpp"
+#include "Pricer.hpp"
+#include "PricerOptions.hpp"
+
+namespace
+{
+    // Reads the options of a CSV file
+    std::vector<OptionData> readOptions(const std::string& path)
+    {
+        std::vector<OptionData> options;
+        for (const auto& record : readCsv(path))
+        {
+            record.expect(7, "K,T,r,sig,S,D,type");
+            options.emplace_back(record.number(0), record.number(1), record.number(2), record.number(3),
+                                 record.number(4), 0ul, record.number(5), static_cast<int>(record.number(6)));
+        }
+
+        return options;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    CommandLine commandLine(argc, argv);
+    if (!commandLine.has("options"))
+    {
+        std::cerr << "Usage: PriceChain --options <file> [--nt <n>] [--nsim <n>] [--threads <n>] [--engine <name>] "
+                     "[--seed <n>]" << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        std::vector<OptionData> options = readOptions(commandLine.get("options", ""));
+
+        PricerConfig config;
+        config.NT = commandLine.getLong("nt", config.NT);
+        config.NSIM = commandLine.getUnsignedLong("nsim", config.NSIM);
+        readWorkerOptions(commandLine, config);
+        readEngineOption(commandLine, config, std::cout);
+
+        OptionChain chain(options, config);
+        auto start = std::chrono::steady_clock::now();
+        std::vector<ChainResult> results = chain.price();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "K, T, Type, Price, Standard Error, Delta, Vega, Black Scholes" << std::endl;
+        for (const auto& result : results)
+        {
+            const OptionData& option = result.optionData;
+            std::cout << option.K << ", " << option.T << ", " << option.type << ", " << result.price << ", "
+                      << std::exp(-option.r * option.T) * result.payoffs.standardError() << ", " << result.delta
+                      << ", " << result.vega << ", " << blackScholes(option).price << std::endl;
+        }
+        std::cout << "Options: " << options.size() << ", path sets: " << chain.groupCount() << std::endl;
+        std::cout << "Wall time (s): " << seconds << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Unable to price the chain - " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,116 @@
+// PriceRequests.cpp
+//
+// Prices a batch of requests through the PricingRouter. Reads one request per line as
+// "K,T,r,sig,S,D,type[,exercise[,model[,method[,budget]]]]" (type 1 == call, -1 == put; exercise european|american,
+// model black-scholes|black-76, method auto|closed-form|lattice|monte-carlo, budget in seconds); blank lines, lines
+// starting with '#' and a header line are skipped. Prints the method that served each request. A request that can't
+// be read or priced gets an error row and the rest of the batch is still priced; the exit code is then 1.
+//
+// Usage: PriceRequests --requests requests.csv [--nt 100] [--nsim 50000] [--threads n] [--engine philox|auto]
+//                      [--seed n] [--pin policy] [--block-size n] [--lattice-steps 1000] [--budget seconds]
+//
+
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "CommandLine.hpp"
+#include "CsvFile.hpp"
+#include "OptionData.hpp"
+#include "Pricer.hpp"
+#include "PricerOptions.hpp"
+#include "PricingRouter.hpp"
+
+namespace
+{
+    // Reads one request. Requests without a budget get the default one.
+    PricingRequest readRequest(const CsvRecord& record, double budget)
+    {
+        record.expect(7, "K,T,r,sig,S,D,type");
+        PricingRequest request{OptionData{record.number(0), record.number(1), record.number(2), record.number(3),
+                                          record.number(4), 0ul, record.number(5), static_cast<int>(record.number(6))}};
+        const std::vector<std::string>& fields = record.fields;
+        if (fields.size() > 7) request.exercise = PricingRouter::getExerciseStyleFromString(fields[7]);
+        if (fields.size() > 8) request.model = PricingRouter::getUnderlyingModelFromString(fields[8]);
+        if (fields.size() > 9) request.method = PricingRouter::getPricingMethodFromString(fields[9]);
+        request.latencyBudget = fields.size() > 10 ? record.number(10) : budget;
+
+        return request;
+    }
+
+    // The field of a record as written, or an empty string if it is missing
+    std::string field(const CsvRecord& record, std::size_t index)
+    {
+        return index < record.fields.size() ? record.fields[index] : "";
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    CommandLine commandLine(argc, argv);
+    if (!commandLine.has("requests"))
+    {
+        std::cerr << "Usage: PriceRequests --requests <file> [--nt <n>] [--nsim <n>] [--threads <n>] "
+                     "[--engine <name>] [--seed <n>] [--lattice-steps <n>] [--budget <seconds>]" << std::endl;
+        return 1;
+    }
+
+    unsigned long failed = 0;
+    try
+    {
+        PricerConfig config;
+        config.NT = commandLine.getLong("nt", config.NT);
+        config.NSIM = commandLine.getUnsignedLong("nsim", config.NSIM);
+        readWorkerOptions(commandLine, config);
+        readEngineOption(commandLine, config, std::cout);
+
+        std::vector<CsvRecord> records = readCsv(commandLine.get("requests", ""));
+        double budget = commandLine.getDouble("budget", 0.0);
+        PricingRouter router(config, static_cast<unsigned int>(commandLine.getLong("lattice-steps", 1000)));
+
+        auto start = std::chrono::steady_clock::now();
+        std::map<std::string, unsigned long> served;
+        std::cout << "K, T, Type, Method, Reason, Price, Standard Error, Delta, Vega, Paths, Capped, Seconds"
+                  << std::endl;
+        for (const auto& record : records)
+        {
+            // A request that can't be read or priced gets an error row, the rest of the batch is still priced
+            try
+            {
+                PricingRequest request = readRequest(record, budget);
+                PricingResponse response = router.price(request);
+                std::string method = PricingRouter::getPricingMethodName(response.method);
+                ++served[method];
+
+                const OptionData& option = request.optionData;
+                std::cout << option.K << ", " << option.T << ", " << option.type << ", " << method << ", "
+                          << response.reason << ", " << response.price << ", " << response.standardError << ", "
+                          << response.delta << ", " << response.vega << ", " << response.paths << ", "
+                          << (response.budgetCapped ? "yes" : "no") << ", " << response.seconds << std::endl;
+            }
+            catch (const std::exception& e)
+            {
+                ++failed;
+                std::cout << field(record, 0) << ", " << field(record, 1) << ", " << field(record, 6) << ", error, \""
+                          << e.what() << "\", , , , , , ," << std::endl;
+            }
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "Requests: " << records.size();
+        for (const auto& [method, count] : served) std::cout << ", " << method << ": " << count;
+        if (failed > 0) std::cout << ", failed: " << failed;
+        std::cout << std::endl << "Wall time (s): " << seconds << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Unable to price the requests - " << e.what() << std::endl;
+        return 1;
+    }
+
+    return failed > 0 ? 1 : 0;
+}
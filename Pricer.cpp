@@ -0,0 +1,411 @@
+//
+// Multi-threaded Monte Carlo pricer for the one factor Black Scholes SDE using the explicit Euler method,
+// optionally Richardson-extrapolated from NT and 2 NT steps on the same Brownian paths.
+// The path space is cut into fixed size blocks and the path kernel is instantiated for the engine chosen from the
+// EngineRegistry. Every engine is positioned per block (Philox per path), so a block gives the same statistics no
+// matter which thread, shard or process prices it. The workers of a WorkerPool allocate their path buffers and
+// block results on their own NUMA node. The blocks are reduced in index order once at the end, which also lets a
+// run resume from a checkpoint of finished blocks and still produce the result of an uninterrupted run.
+//
+
+#include "Pricer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Checkpointer.hpp"
+#include "Euler.hpp"
+#include "NormalPool.hpp"
+#include "PartialResult.hpp"
+#include "PathExporter.hpp"
+#include "ProgressReporter.hpp"
+#include "SDE.hpp"
+#include "WorkerPool.hpp"
+
+/**
+ * Overloaded ctor
+ * @param _optionData The option to price. The initial value of the SDE is the spot price S.
+ * @param _config Discretisation, number of simulations, thread placement and shard
+ * @throws std::invalid_argument if NT or NSIM is 0, a Richardson run exports or sketches its paths, the engine isn't
+ *         registered or the normal pool of the config doesn't cover the run
+ */
+Pricer::Pricer(const OptionData& _optionData, PricerConfig _config)
+    : optionData{_optionData}, config{std::move(_config)}
+{
+    validate(config);
+    if (config.threads == 0) config.threads = 1;
+    if (config.blockSize == 0) config.blockSize = 1;
+    if (config.shards == 0) config.shards = 1;
+
+    // Fails early for ids that aren't registered
+    getEngineName(config.engine);
+
+    if (!config.normalPool.empty())
+    {
+        pool = std::make_shared<const NormalPool>(config.normalPool);
+        if (config.engine != EngineId::PHILOX)
+        {
+            throw std::invalid_argument("Normal pools hold Philox streams and can't stand in for " +
+                                        getEngineName(config.engine));
+        }
+        if (pool->seed() != config.seed || pool->streams() < config.NSIM ||
+            pool->streamLength() < normalsPerPath(config))
+        {
+            throw std::invalid_argument("Normal pool " + config.normalPool + " holds " +
+                                        std::to_string(pool->streams()) + " paths of " +
+                                        std::to_string(pool->streamLength()) + " normals for seed " +
+                                        std::to_string(pool->seed()) + ", which doesn't cover this run");
+        }
+    }
+}
+
+/**
+ * Overloaded ctor that resumes an interrupted run
+ * @param _optionData The option to price. The initial value of the SDE is the spot price S.
+ * @param _config Discretisation, number of simulations, thread placement and shard. Must match the interrupted run.
+ * @param _resumed Blocks restored from a checkpoint of the interrupted run. They are not priced again.
+ */
+Pricer::Pricer(const OptionData& _optionData, PricerConfig _config, std::vector<BlockResult> _resumed)
+    : Pricer{_optionData, std::move(_config)}
+{
+    resumed = std::move(_resumed);
+}
+
+/**
+ * Number of blocks the path space is cut into. The last block may be partially filled.
+ * @param config The configuration of the run
+ * @return The number of blocks
+ */
+unsigned long Pricer::blockCount(const PricerConfig& config)
+{
+    return (config.NSIM + config.blockSize - 1) / config.blockSize;
+}
+
+/**
+ * The contiguous range of blocks owned by the shard of a run
+ * @param config The configuration of the run
+ * @return The first block and one past the last block of the shard
+ */
+std::pair<unsigned long, unsigned long> Pricer::shardBlocks(const PricerConfig& config)
+{
+    unsigned long blocks = blockCount(config);
+    return {blocks * config.shard / config.shards, blocks * (config.shard + 1) / config.shards};
+}
+
+/**
+ * Clears the options that only a run driven by TestMC uses: sharding, checkpoints, normal pools, progress reports,
+ * path exports and distribution sketches. Classes that price their own passes in memory start from this.
+ * @param config Any configuration
+ * @return The configuration of a single in-memory run of the whole path space
+ */
+PricerConfig Pricer::standalone(PricerConfig config)
+{
+    config.shard = 0;
+    config.shards = 1;
+    config.checkpointPath.clear();
+    config.normalPool.clear();
+    config.progressInterval = 0.0;
+    config.pathExport.clear();
+    config.distributions = false;
+
+    return config;
+}
+
+/**
+ * Checks the discretisation of a run and that its outputs fit its scheme
+ * @param config The configuration of the run
+ * @throws std::invalid_argument if the run has no time steps or no paths, or exports or sketches the paths of a
+ *         Richardson run
+ */
+void Pricer::validate(const PricerConfig& config)
+{
+    if (config.NT < 1)
+    {
+        throw std::invalid_argument("Invalid number of time steps " + std::to_string(config.NT) +
+                                    ", expected at least 1");
+    }
+    if (config.NSIM < 1) throw std::invalid_argument("Invalid number of simulations 0, expected at least 1");
+    if (config.richardson && (!config.pathExport.empty() || config.distributions))
+    {
+        throw std::invalid_argument("Path exports and distributions aren't supported with Richardson extrapolation");
+    }
+}
+
+/**
+ * Number of standard normals each path draws: one per time step, or one per fine step in Richardson mode
+ * @param config The configuration of the run
+ * @return NT or 2 NT
+ */
+std::size_t Pricer::normalsPerPath(const PricerConfig& config)
+{
+    return static_cast<std::size_t>(config.NT) * (config.richardson ? 2 : 1);
+}
+
+/**
+ * Discounts the statistics of the payoffs
+ * @param optionData The option that was priced
+ * @param payoffs Statistics of the undiscounted payoffs
+ * @return The price and pathwise greeks
+ */
+PricerResult Pricer::summarise(const OptionData& optionData, const Accumulator& payoffs)
+{
+    double discount = std::exp(-optionData.r * optionData.T);
+
+    PricerResult result;
+    result.payoffs = payoffs;
+    result.price = discount * payoffs.mean;
+    result.delta = discount * payoffs.deltaMean;
+    result.vega = discount * payoffs.vegaMean;
+    result.bias = discount * payoffs.biasMean;
+
+    return result;
+}
+
+/**
+ * Prices the blocks of this run's shard that haven't been resumed. The pending blocks are split into one
+ * contiguous range per worker. A Checkpointer periodically persists the blocks that have been published and a
+ * ProgressReporter periodically prints how far the workers got.
+ * @return The discounted price along with the statistics of the payoffs
+ */
+PricerResult Pricer::price() const
+{
+    auto start = std::chrono::steady_clock::now();
+    auto [firstBlock, lastBlock] = shardBlocks(config);
+
+    // Blocks of the shard that still need to be priced
+    std::vector<bool> done(lastBlock - firstBlock, false);
+    for (const auto& block : resumed)
+    {
+        if (block.index >= firstBlock && block.index < lastBlock) done[block.index - firstBlock] = true;
+    }
+    std::vector<unsigned long> pending;
+    for (unsigned long b = firstBlock; b < lastBlock; ++b)
+    {
+        if (!done[b - firstBlock]) pending.push_back(b);
+    }
+
+    WorkerPool pool(config, topology);
+    std::vector<WorkerProgress> progress(pool.size());
+
+    // Every block that has been published so far, including the resumed ones
+    auto snapshot = [this, &progress]
+    {
+        std::vector<BlockResult> blocks = resumed;
+        for (const auto& worker : progress)
+        {
+            std::size_t completed = worker.completed.load(std::memory_order_acquire);
+            if (completed == 0) continue;
+            blocks.insert(blocks.end(), worker.blocks.begin(), worker.blocks.begin() + completed);
+        }
+        return PartialResult{optionData, config, std::move(blocks)};
+    };
+
+    std::unique_ptr<Checkpointer> checkpointer;
+    if (!config.checkpointPath.empty())
+    {
+        checkpointer = std::make_unique<Checkpointer>(snapshot, config.checkpointPath, config.checkpointInterval);
+        checkpointer->start();
+    }
+
+    // Running totals for the progress reports. Paths are counted per worker, the price covers the published blocks.
+    std::unique_ptr<ProgressReporter> reporter;
+    if (config.progressInterval > 0.0)
+    {
+        unsigned long pathsTotal = 0;
+        for (unsigned long b = firstBlock; b < lastBlock; ++b)
+        {
+            pathsTotal += std::min(config.NSIM, (b + 1) * config.blockSize) - b * config.blockSize;
+        }
+        Accumulator resumedPayoffs;
+        for (const auto& block : resumed)
+        {
+            if (block.index >= firstBlock && block.index < lastBlock) resumedPayoffs.merge(block.payoffs);
+        }
+
+        auto sample = [this, &progress, pathsTotal, resumedPayoffs]
+        {
+            ProgressSnapshot snapshot;
+            snapshot.pathsTotal = pathsTotal;
+            snapshot.pathsResumed = resumedPayoffs.count;
+            snapshot.pathsDone = resumedPayoffs.count;
+
+            Accumulator payoffs = resumedPayoffs;
+            for (const auto& worker : progress)
+            {
+                snapshot.pathsDone += worker.paths.load(std::memory_order_relaxed);
+                std::size_t completed = worker.completed.load(std::memory_order_acquire);
+                for (std::size_t j = 0; j < completed; ++j) payoffs.merge(worker.blocks[j].payoffs);
+            }
+
+            double discount = std::exp(-optionData.r * optionData.T);
+            snapshot.pathsPriced = payoffs.count;
+            snapshot.price = discount * payoffs.mean;
+            snapshot.standardError = discount * payoffs.standardError();
+            return snapshot;
+        };
+        reporter = std::make_unique<ProgressReporter>(sample, config.progressInterval, std::cout);
+        reporter->start();
+    }
+
+    // Optional export of every terminal value and payoff, written behind the workers' backs
+    std::unique_ptr<PathExporter> exporter;
+    if (!config.pathExport.empty())
+    {
+        exporter = std::make_unique<PathExporter>(config.pathExport, static_cast<std::uint32_t>(config.engine),
+                                                  config.seed, config.NSIM, config.NT, config.blockSize,
+                                                  pool.size());
+        exporter->start();
+    }
+
+    // The engine is resolved once here, each worker runs the kernel instantiated for it
+    dispatchEngine(config.engine, [&](auto engine)
+    {
+        using Engine = typename decltype(engine)::type;
+        pool.run(pending.size(), [&](unsigned int worker, std::size_t first, std::size_t last)
+        {
+            runWorker<Engine>(pending.data() + first, last - first, progress[worker], exporter.get(), worker);
+        });
+    });
+    if (reporter) reporter->stop();
+
+    PricerMetrics metrics;
+    if (checkpointer)
+    {
+        CheckpointMetrics checkpoints = checkpointer->stop();
+        metrics.checkpoints = checkpoints.checkpoints;
+        metrics.checkpointSeconds = checkpoints.seconds;
+        metrics.checkpointBytes = checkpoints.bytes;
+    }
+    if (exporter)
+    {
+        PathExportMetrics exported = exporter->stop();
+        metrics.exportBytes = exported.bytes;
+        metrics.exportStallSeconds = exported.stallSeconds;
+    }
+
+    // Final reduction in block order, which doesn't depend on the number of workers, shards or resumes
+    PartialResult blocks = snapshot();
+    PricerResult result = summarise(optionData, blocks.reduce());
+    result.blocks = std::move(blocks.blocks);
+    if (config.distributions)
+    {
+        for (const auto& worker : progress)
+        {
+            result.terminals.merge(worker.terminals);
+            result.payoffDistribution.merge(worker.payoffs);
+        }
+    }
+
+    metrics.resumedBlocks = static_cast<unsigned long>(result.blocks.size() - pending.size());
+    for (unsigned long b : pending)
+    {
+        metrics.pathsSimulated += std::min(config.NSIM, (b + 1) * config.blockSize) - b * config.blockSize;
+    }
+    metrics.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.metrics = metrics;
+
+    return result;
+}
+
+/**
+ * Simulates the blocks that belong to one worker, on the worker's pinned thread. Instantiated once per registered
+ * engine.
+ * @param pending Indices of the worker's blocks
+ * @param count Number of blocks
+ * @param progress Receives the statistics of each block as soon as it is finished
+ * @param exporter Receives the terminal values and payoffs of each block, or nullptr
+ * @param worker Index of the worker, i.e. its lane of the exporter
+ */
+template <typename Engine>
+void Pricer::runWorker(const unsigned long* pending, std::size_t count, WorkerProgress& progress,
+                       PathExporter* exporter, unsigned int worker) const
+{
+    progress.blocks.resize(count);
+    std::vector<double> dW(normalsPerPath(config));
+
+    Engine rng{config.seed};
+    SDE sde(optionData);
+    long NT = config.NT;
+    double k = optionData.T / double (NT);
+
+    unsigned long pathsDone = 0;
+    for (std::size_t j = 0; j < count; ++j)
+    {
+        unsigned long b = pending[j];
+        BlockResult& block = progress.blocks[j];
+        block.index = b;
+        if (!pool) rng.beginBlock(b);
+        PathBuffer* exported = exporter ? &exporter->acquire(worker, b) : nullptr;
+
+        unsigned long lastPath = std::min(config.NSIM, (b + 1) * config.blockSize);
+        for (unsigned long path = b * config.blockSize; path < lastPath; ++path)
+        { // Calculate a path at each iteration
+
+            // Either stream the path's normals from the pool or generate them
+            const double* increments = dW.data();
+            if (pool) increments = pool->stream(path);
+            else rng.fillPath(path, dW.data(), dW.size());
+
+            PathEnd end;
+            double payoff, delta, vega, bias = 0.0;
+            if (!config.richardson)
+            {
+                end = euler<1>(sde, optionData.S, increments, NT, k, std::sqrt(k));
+                payoff = optionData.myPayOffFunction(end.V);
+
+                // Pathwise greeks. The Euler path is linear in S_0, so dS_T/dS_0 = S_T/S_0.
+                double slope = optionData.myPayOffDerivative(end.V);
+                delta = slope * end.V / optionData.S;
+                vega = slope * end.dV;
+            }
+            else
+            {
+                // 2 NT fine steps, and NT coarse steps whose increments are the sums of pairs of fine ones
+                end = euler<1>(sde, optionData.S, increments, 2 * NT, 0.5 * k, std::sqrt(0.5 * k));
+                PathEnd coarse = euler<2>(sde, optionData.S, increments, NT, k, std::sqrt(0.5 * k));
+
+                double fine = optionData.myPayOffFunction(end.V);
+                double fineSlope = optionData.myPayOffDerivative(end.V);
+                double coarsePayoff = optionData.myPayOffFunction(coarse.V);
+                double coarseSlope = optionData.myPayOffDerivative(coarse.V);
+
+                // The weak error is O(k), so 2 V_fine - V_coarse cancels its leading term, and the bias of the
+                // coarse estimate is 2 (V_coarse - V_fine)
+                payoff = 2.0 * fine - coarsePayoff;
+                delta = (2.0 * fineSlope * end.V - coarseSlope * coarse.V) / optionData.S;
+                vega = 2.0 * fineSlope * end.dV - coarseSlope * coarse.dV;
+                bias = 2.0 * (coarsePayoff - fine);
+            }
+
+            // Spurious values
+            block.payoffs.originHits += end.originHits;
+            block.payoffs.add(payoff, delta, vega, bias);
+
+            if (exported)
+            {
+                exported->terminals.push_back(end.V);
+                exported->payoffs.push_back(payoff);
+            }
+            if (config.distributions)
+            {
+                progress.terminals.add(end.V);
+                progress.payoffs.add(payoff);
+            }
+
+            // Only this worker writes the counter, so a relaxed store is enough and no read-modify-write is needed
+            progress.paths.store(++pathsDone, std::memory_order_relaxed);
+        }
+
+        if (exported) exporter->submit(worker);
+        progress.completed.store(j + 1, std::memory_order_release);
+    }
+}
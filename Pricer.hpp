@@ -0,0 +1,131 @@
+//
+// Multi-threaded Monte Carlo pricer for the one factor Black Scholes SDE using the explicit Euler method,
+// optionally Richardson-extrapolated from NT and 2 NT steps on the same Brownian paths.
+// The path space is cut into fixed size blocks and the path kernel is instantiated for the engine chosen from the
+// EngineRegistry. Every engine is positioned per block (Philox per path), so a block gives the same statistics no
+// matter which thread, shard or process prices it. The workers of a WorkerPool allocate their path buffers and
+// block results on their own NUMA node. The blocks are reduced in index order once at the end, which also lets a
+// run resume from a checkpoint of finished blocks and still produce the result of an uninterrupted run.
+//
+
+#ifndef MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_PRICER_HPP
+#define MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_PRICER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Accumulator.hpp"
+#include "DistributionSketch.hpp"
+#include "EngineRegistry.hpp"
+#include "OptionData.hpp"
+#include "Topology.hpp"
+
+class NormalPool;
+class PathExporter;
+
+struct PricerConfig
+{
+    long NT = 100;                                  // Number of time steps
+    unsigned long NSIM = 50'000;                    // Number of simulations
+    unsigned int threads = 1;                       // Number of workers
+    PinningPolicy pinning = PinningPolicy::NONE;    // Placement of the workers
+    std::vector<int> cpus;                          // CPUs used by PinningPolicy::EXPLICIT
+    EngineId engine = EngineId::PHILOX;             // Engine the path kernel is instantiated with
+    unsigned long seed = 0;                         // Seed of the engine
+    unsigned long blockSize = 4096;                 // Number of paths per block
+    unsigned int shard = 0;                         // Index of the slice of blocks priced by this process
+    unsigned int shards = 1;                        // Number of slices the blocks are split into
+    std::string checkpointPath;                     // Checkpoint file. Empty disables checkpointing.
+    double checkpointInterval = 60.0;               // Seconds between two checkpoints
+    std::string normalPool;                         // Pre-generated normals to read instead of Philox. May be empty.
+    double progressInterval = 0.0;                  // Seconds between two progress reports. 0 disables them.
+    std::string pathExport;                         // File receiving every terminal value and payoff. May be empty.
+    bool distributions = false;                     // Sketch the distributions of terminal values and payoffs
+    bool richardson = false;                        // Extrapolate NT and 2 NT steps taken on the same Brownian paths
+};
+
+struct BlockResult
+{
+    unsigned long index = 0;            // Index of the block. Block b holds paths [b * blockSize, (b + 1) * blockSize)
+    Accumulator payoffs;                // Statistics of the block's paths
+};
+
+struct PricerMetrics
+{
+    double wallSeconds = 0.0;           // Wall time of the run
+    unsigned long pathsSimulated = 0;   // Paths priced by this run, excluding resumed blocks
+    unsigned long resumedBlocks = 0;    // Blocks restored from a checkpoint
+    unsigned long checkpoints = 0;      // Number of checkpoints written
+    double checkpointSeconds = 0.0;     // Time the checkpointer thread spent snapshotting and writing
+    std::size_t checkpointBytes = 0;    // Size of the last checkpoint
+    std::size_t exportBytes = 0;        // Size of the path export
+    double exportStallSeconds = 0.0;    // Time the workers waited on the path export writer
+};
+
+struct PricerResult
+{
+    Accumulator payoffs;                // Statistics of the undiscounted payoffs
+    double price = 0.0;                 // Discounted price
+    double delta = 0.0;                 // Pathwise delta
+    double vega = 0.0;                  // Pathwise vega
+    double bias = 0.0;                  // Estimated discretisation bias of the NT step Euler price (Richardson only)
+    std::vector<BlockResult> blocks;    // Per block statistics, sorted by block index
+    DistributionSketch terminals;       // Distribution of the terminal values, if requested. Excludes resumed blocks.
+    DistributionSketch payoffDistribution;  // Distribution of the undiscounted payoffs, if requested
+    PricerMetrics metrics;              // Timings of the run
+};
+
+class Pricer
+{
+private:
+    // Blocks finished by one worker. The worker writes blocks[i] and then publishes it by storing i + 1 into
+    // completed, so readers on other threads may copy any block below the acquired count. The path counter is
+    // stored after every path and only read for progress reports, so it sits on a cache line of its own.
+    struct alignas(64) WorkerProgress
+    {
+        std::vector<BlockResult> blocks;
+        std::atomic<std::size_t> completed{0};
+        DistributionSketch terminals;
+        DistributionSketch payoffs;
+        alignas(64) std::atomic<unsigned long> paths{0};
+    };
+
+    OptionData optionData;
+    PricerConfig config;
+    Topology topology;
+    std::vector<BlockResult> resumed;
+    std::shared_ptr<const NormalPool> pool;
+
+    template <typename Engine>
+    void runWorker(const unsigned long* pending, std::size_t count, WorkerProgress& progress,
+                   PathExporter* exporter, unsigned int worker) const;
+
+public:
+    Pricer(const OptionData& _optionData, PricerConfig _config);
+    Pricer(const OptionData& _optionData, PricerConfig _config, std::vector<BlockResult> _resumed);
+    Pricer(const Pricer& other) = default;
+    Pricer(Pricer&& other) noexcept = default;
+    virtual ~Pricer() = default;
+
+    // Operator Overloads
+    Pricer& operator=(const Pricer& other) = default;
+    Pricer& operator=(Pricer&& other) noexcept = default;
+
+    // Pricing API
+    PricerResult price() const;
+    static PricerResult summarise(const OptionData& optionData, const Accumulator& payoffs);
+
+    // Block layout
+    static unsigned long blockCount(const PricerConfig& config);
+    static std::pair<unsigned long, unsigned long> shardBlocks(const PricerConfig& config);
+    static std::size_t normalsPerPath(const PricerConfig& config);
+    static PricerConfig standalone(PricerConfig config);
+    static void validate(const PricerConfig& config);
+};
+
+
+#endif //MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_PRICER_HPP
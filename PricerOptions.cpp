@@ -0,0 +1,81 @@
+//
+// Command line options shared by the pricing programs: the worker pool (--threads, --pin, --block-size), the random
+// number engine (--engine) and its seed (--seed).
+//
+
+#include "PricerOptions.hpp"
+
+#include <algorithm>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "EngineRegistry.hpp"
+#include "EngineTuner.hpp"
+#include "Topology.hpp"
+
+/**
+ * Reads a number of worker threads, e.g. --threads 8. Defaults to the number of hardware threads.
+ * @param commandLine The arguments of the program
+ * @return The number of threads, at least 1
+ * @throws std::invalid_argument if the value isn't a whole number between 1 and MAX_THREADS
+ */
+unsigned int readThreads(const CommandLine& commandLine)
+{
+    unsigned long threads = commandLine.getUnsignedLong("threads", std::max(1u, std::thread::hardware_concurrency()));
+    if (threads < 1 || threads > MAX_THREADS)
+    {
+        throw std::invalid_argument("Invalid value '" + commandLine.get("threads", "") +
+                                    "' for --threads, expected 1 to " + std::to_string(MAX_THREADS));
+    }
+
+    return static_cast<unsigned int>(threads);
+}
+
+/**
+ * Reads the size and placement of the worker pool and the seed, e.g. --threads 8 --pin compact --seed 42. Threads
+ * default to the hardware concurrency; flags that aren't given leave the config unchanged otherwise.
+ * @param commandLine The arguments of the program
+ * @param config Receives threads, pinning, cpus, seed and blockSize
+ * @throws std::invalid_argument if a value isn't a number, --threads is out of range or --pin isn't a policy or CPU
+ *         list
+ */
+void readWorkerOptions(const CommandLine& commandLine, PricerConfig& config)
+{
+    config.threads = readThreads(commandLine);
+    config.pinning = Topology::getPinningPolicyFromString(commandLine.get("pin", "none"));
+    if (config.pinning == PinningPolicy::EXPLICIT) config.cpus = Topology::parseCpuList(commandLine.get("pin", ""));
+    config.seed = commandLine.getUnsignedLong("seed", config.seed);
+    config.blockSize = commandLine.getUnsignedLong("block-size", config.blockSize);
+}
+
+/**
+ * Reads the random number engine, e.g. --engine mersenne-twister. --engine auto benchmarks the registered engines
+ * on this host, reports each one and picks the fastest candidate that passes the quality gates; the benchmark draws
+ * streams as long as a path of the config, so NT and richardson must be set first.
+ * @param commandLine The arguments of the program
+ * @param config Receives the engine
+ * @param log Receives the benchmark of each engine under --engine auto
+ * @throws std::invalid_argument if the engine isn't registered
+ * @throws std::runtime_error if no engine passes the quality gates under --engine auto
+ */
+void readEngineOption(const CommandLine& commandLine, PricerConfig& config, std::ostream& log)
+{
+    std::string engine = commandLine.get("engine", "philox");
+    if (engine != "auto")
+    {
+        config.engine = getEngineIdFromName(engine);
+        return;
+    }
+
+    std::vector<EngineBenchmark> benchmarks = EngineTuner(config.seed, Pricer::normalsPerPath(config)).benchmark();
+    for (const auto& benchmark : benchmarks)
+    {
+        log << benchmark.name << ": " << benchmark.nanosPerVariate << " ns per variate, "
+            << (benchmark.passed ? "passed" : "failed " + benchmark.failure)
+            << (benchmark.candidate ? "" : ", only selectable by name") << std::endl;
+    }
+    config.engine = EngineTuner::select(benchmarks);
+}
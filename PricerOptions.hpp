@@ -0,0 +1,21 @@
+//
+// Command line options shared by the pricing programs: the worker pool (--threads, --pin, --block-size), the random
+// number engine (--engine) and its seed (--seed).
+//
+
+#ifndef MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_PRICEROPTIONS_HPP
+#define MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_PRICEROPTIONS_HPP
+
+#include <ostream>
+
+#include "CommandLine.hpp"
+#include "Pricer.hpp"
+
+constexpr unsigned long MAX_THREADS = 4096;     // More workers than this is a typo rather than a machine
+
+unsigned int readThreads(const CommandLine& commandLine);
+void readWorkerOptions(const CommandLine& commandLine, PricerConfig& config);
+void readEngineOption(const CommandLine& commandLine, PricerConfig& config, std::ostream& log);
+
+
+#endif //MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_PRICEROPTIONS_HPP
@@ -0,0 +1,262 @@
+//
+// Routes pricing requests to the cheapest method that serves them exactly: closed form Black Scholes or Black 76
+// for European options (and American calls that are never exercised early), a binomial lattice for American options
+// and the Monte Carlo pricer only when it is asked for. A simulation may carry a latency budget, in which case the
+// number of paths is capped by the throughput the router measured on its previous simulations and the response
+// reports the standard error that was reached.
+//
+
+#include "PricingRouter.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "BlackScholes.hpp"
+#include "Lattice.hpp"
+
+namespace
+{
+    constexpr double BUDGET_SAFETY = 0.8;   // Share of the remaining budget the paths are sized for, leaving room
+                                            // for thread start-up and the reduction
+
+    double secondsSince(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+/**
+ * Overloaded ctor
+ * @param _config Template of every simulation: time steps, default simulations, threads, engine, seed and
+ *                placement. See Pricer::standalone for the options a simulation ignores.
+ * @param _latticeSteps Time steps of the binomial lattice
+ */
+PricingRouter::PricingRouter(PricerConfig _config, unsigned int _latticeSteps)
+    : config{Pricer::standalone(std::move(_config))}, latticeSteps{_latticeSteps}
+{
+
+}
+
+/**
+ * Chooses the method of a request
+ * @param request The request
+ * @param reason Receives why the method was chosen
+ * @return The method, never AUTO
+ * @throws std::invalid_argument if the request asks for a method that can't price it
+ */
+PricingMethod PricingRouter::route(const PricingRequest& request, std::string& reason) const
+{
+    bool american = request.exercise == ExerciseStyle::AMERICAN;
+
+    // An American call on an asset paying no dividend is never exercised early, so it is worth the European call.
+    // A future costs nothing to carry, so the argument doesn't hold under Black 76.
+    bool europeanValue = !american || (request.optionData.type == 1 && request.optionData.D <= 0.0 &&
+                                       request.model == UnderlyingModel::BLACK_SCHOLES);
+
+    switch (request.method)
+    {
+        case PricingMethod::AUTO:
+            if (europeanValue)
+            {
+                reason = american ? "american call without dividends" : "european vanilla";
+                return PricingMethod::CLOSED_FORM;
+            }
+            reason = "early exercise";
+            return PricingMethod::LATTICE;
+
+        case PricingMethod::CLOSED_FORM:
+            if (!europeanValue) throw std::invalid_argument("No closed form for an American option exercised early");
+            reason = "requested";
+            return PricingMethod::CLOSED_FORM;
+
+        case PricingMethod::LATTICE:
+            reason = "requested";
+            return PricingMethod::LATTICE;
+
+        case PricingMethod::MONTE_CARLO:
+            if (american) throw std::invalid_argument("The Monte Carlo pricer doesn't support early exercise");
+            reason = "requested";
+            return PricingMethod::MONTE_CARLO;
+    }
+
+    throw std::invalid_argument("Unknown pricing method");
+}
+
+/**
+ * Prices a European request with the Monte Carlo pricer. Under a latency budget the number of paths is capped by
+ * the throughput of the previous simulations. The first budgeted simulation measures the throughput on a pilot of
+ * one block per worker. The pilot's blocks are resumed by the main run, as from a checkpoint, so the budget is only
+ * spent on the paths that are still missing and the estimate is the one of a single run over every path.
+ * @param request The request
+ * @param optionData The option as simulated, with D == r under Black 76
+ * @param response Receives the price, greeks, standard error and paths of the run
+ */
+void PricingRouter::simulate(const PricingRequest& request, const OptionData& optionData,
+                             PricingResponse& response) const
+{
+    auto start = std::chrono::steady_clock::now();
+
+    PricerConfig runConfig = config;
+    unsigned long NSIM = optionData.NSIM > 0 ? optionData.NSIM : config.NSIM;
+    double stepsPerPath = static_cast<double>(Pricer::normalsPerPath(config));
+
+    PricerResult result;
+    std::vector<BlockResult> pilot;
+    unsigned long pilotPaths = 0;
+    if (request.latencyBudget > 0.0)
+    {
+        double rate = stepsPerSecond.load(std::memory_order_relaxed);
+        if (rate <= 0.0)
+        {
+            // Whole blocks, unless the request needs fewer paths, so the main run can resume them
+            runConfig.NSIM = std::min(NSIM, config.blockSize * std::max(1u, config.threads));
+            result = Pricer(optionData, runConfig).price();
+            pilot = result.blocks;
+            pilotPaths = result.payoffs.count;
+            if (result.metrics.wallSeconds > 0.0)
+            {
+                rate = static_cast<double>(pilotPaths) * stepsPerPath / result.metrics.wallSeconds;
+                stepsPerSecond.store(rate, std::memory_order_relaxed);
+            }
+        }
+
+        double remaining = request.latencyBudget - secondsSince(start);
+        double affordable = remaining > 0.0 && rate > 0.0 ? BUDGET_SAFETY * remaining * rate / stepsPerPath : 0.0;
+        if (static_cast<double>(pilotPaths) + affordable < static_cast<double>(NSIM))
+        {
+            NSIM = std::max(pilotPaths + static_cast<unsigned long>(affordable), std::min(NSIM, config.blockSize));
+            response.budgetCapped = true;
+        }
+    }
+
+    if (NSIM > pilotPaths)
+    {
+        runConfig.NSIM = NSIM;
+        result = Pricer(optionData, runConfig, std::move(pilot)).price();
+        if (result.metrics.wallSeconds > 0.0)
+        {
+            stepsPerSecond.store(static_cast<double>(result.metrics.pathsSimulated) * stepsPerPath /
+                                 result.metrics.wallSeconds, std::memory_order_relaxed);
+        }
+    }
+
+    response.price = result.price;
+    response.delta = result.delta;
+    response.vega = result.vega;
+    response.standardError = std::exp(-optionData.r * optionData.T) * result.payoffs.standardError();
+    response.paths = result.payoffs.count;
+    response.steps = config.NT;
+}
+
+/**
+ * Prices a request with the method it is routed to. Safe to call from several threads at once.
+ * @param request The request
+ * @return The price and greeks, with the method that served the request
+ * @throws std::invalid_argument if the request asks for a method that can't price it
+ */
+PricingResponse PricingRouter::price(const PricingRequest& request) const
+{
+    auto start = std::chrono::steady_clock::now();
+
+    PricingResponse response;
+    response.method = route(request, response.reason);
+
+    // Black 76 is Black Scholes with a dividend yield equal to the interest rate, for every method
+    OptionData optionData = request.optionData;
+    if (request.model == UnderlyingModel::BLACK_76) optionData.D = optionData.r;
+
+    switch (response.method)
+    {
+        case PricingMethod::CLOSED_FORM:
+        {
+            BlackScholesResult result = request.model == UnderlyingModel::BLACK_76 ? black76(request.optionData)
+                                                                                   : blackScholes(optionData);
+            response.price = result.price;
+            response.delta = result.delta;
+            response.vega = result.vega;
+            break;
+        }
+        case PricingMethod::LATTICE:
+        {
+            LatticeResult result = binomialLattice(optionData, request.exercise == ExerciseStyle::AMERICAN,
+                                                   latticeSteps);
+            response.price = result.price;
+            response.delta = result.delta;
+            response.vega = result.vega;
+            response.steps = latticeSteps;
+            break;
+        }
+        default:
+            simulate(request, optionData, response);
+            break;
+    }
+
+    response.seconds = secondsSince(start);
+
+    return response;
+}
+
+/**
+ * Converts a method name into a PricingMethod
+ * @param desc One of auto, closed-form, lattice and monte-carlo
+ * @return The method
+ * @throws std::invalid_argument for any other name
+ */
+PricingMethod PricingRouter::getPricingMethodFromString(const std::string& desc)
+{
+    if (desc == "auto") return PricingMethod::AUTO;
+    if (desc == "closed-form") return PricingMethod::CLOSED_FORM;
+    if (desc == "lattice") return PricingMethod::LATTICE;
+    if (desc == "monte-carlo") return PricingMethod::MONTE_CARLO;
+
+    throw std::invalid_argument("Unknown pricing method " + desc);
+}
+
+/**
+ * Names a PricingMethod
+ * @param method The method
+ * @return The name accepted by getPricingMethodFromString
+ */
+std::string PricingRouter::getPricingMethodName(PricingMethod method)
+{
+    switch (method)
+    {
+        case PricingMethod::CLOSED_FORM: return "closed-form";
+        case PricingMethod::LATTICE: return "lattice";
+        case PricingMethod::MONTE_CARLO: return "monte-carlo";
+        default: return "auto";
+    }
+}
+
+/**
+ * Converts an exercise name into an ExerciseStyle
+ * @param desc european or american
+ * @return The exercise style
+ * @throws std::invalid_argument for any other name
+ */
+ExerciseStyle PricingRouter::getExerciseStyleFromString(const std::string& desc)
+{
+    if (desc == "european") return ExerciseStyle::EUROPEAN;
+    if (desc == "american") return ExerciseStyle::AMERICAN;
+
+    throw std::invalid_argument("Unknown exercise style " + desc);
+}
+
+/**
+ * Converts a model name into an UnderlyingModel
+ * @param desc black-scholes or black-76
+ * @return The model
+ * @throws std::invalid_argument for any other name
+ */
+UnderlyingModel PricingRouter::getUnderlyingModelFromString(const std::string& desc)
+{
+    if (desc == "black-scholes") return UnderlyingModel::BLACK_SCHOLES;
+    if (desc == "black-76") return UnderlyingModel::BLACK_76;
+
+    throw std::invalid_argument("Unknown underlying model " + desc);
+}
@@ -0,0 +1,91 @@
+//
+// Routes pricing requests to the cheapest method that serves them exactly: closed form Black Scholes or Black 76
+// for European options (and American calls that are never exercised early), a binomial lattice for American options
+// and the Monte Carlo pricer only when it is asked for. A simulation may carry a latency budget, in which case the
+// number of paths is capped by the throughput the router measured on its previous simulations and the response
+// reports the standard error that was reached.
+//
+
+#ifndef MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_PRICINGROUTER_HPP
+#define MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_PRICINGROUTER_HPP
+
+#include <atomic>
+#include <string>
+
+#include "OptionData.hpp"
+#include "Pricer.hpp"
+
+enum class ExerciseStyle
+{
+    EUROPEAN,
+    AMERICAN
+};
+
+enum class UnderlyingModel
+{
+    BLACK_SCHOLES,                      // Spot asset paying the continuous dividend yield D
+    BLACK_76                            // Futures contract, S is the futures price and D is ignored
+};
+
+enum class PricingMethod
+{
+    AUTO,
+    CLOSED_FORM,
+    LATTICE,
+    MONTE_CARLO
+};
+
+struct PricingRequest
+{
+    OptionData optionData;                          // The option. NSIM == 0 uses the router's number of simulations.
+    ExerciseStyle exercise = ExerciseStyle::EUROPEAN;
+    UnderlyingModel model = UnderlyingModel::BLACK_SCHOLES;
+    PricingMethod method = PricingMethod::AUTO;     // Method to use, AUTO lets the router choose
+    double latencyBudget = 0.0;                     // Seconds a simulation may take. 0 disables the budget.
+};
+
+struct PricingResponse
+{
+    PricingMethod method = PricingMethod::AUTO;     // Method that served the request
+    std::string reason;                             // Why the method was chosen
+    double price = 0.0;                             // Discounted price
+    double delta = 0.0;                             // Derivative of the price w.r.t. S
+    double vega = 0.0;                              // Derivative of the price w.r.t. volatility
+    double standardError = 0.0;                     // Standard error of the price, 0 for deterministic methods
+    unsigned long paths = 0;                        // Paths in the estimate, including a throughput pilot
+    long steps = 0;                                 // Time steps of the lattice or of each path
+    bool budgetCapped = false;                      // True if the latency budget reduced the number of paths
+    double seconds = 0.0;                           // Wall time spent on the request
+};
+
+class PricingRouter
+{
+private:
+    PricerConfig config;
+    unsigned int latticeSteps;
+    mutable std::atomic<double> stepsPerSecond{0.0};    // Simulation throughput measured by the last run
+
+    PricingMethod route(const PricingRequest& request, std::string& reason) const;
+    void simulate(const PricingRequest& request, const OptionData& optionData, PricingResponse& response) const;
+
+public:
+    explicit PricingRouter(PricerConfig _config, unsigned int _latticeSteps = 1000);
+    PricingRouter(const PricingRouter& other) = delete;
+    PricingRouter(PricingRouter&& other) noexcept = delete;
+    virtual ~PricingRouter() = default;
+
+    // Operator Overloads
+    PricingRouter& operator=(const PricingRouter& other) = delete;
+    PricingRouter& operator=(PricingRouter&& other) noexcept = delete;
+
+    // Routing API
+    PricingResponse price(const PricingRequest& request) const;
+
+    static PricingMethod getPricingMethodFromString(const std::string& desc);
+    static std::string getPricingMethodName(PricingMethod method);
+    static ExerciseStyle getExerciseStyleFromString(const std::string& desc);
+    static UnderlyingModel getUnderlyingModelFromString(const std::string& desc);
+};
+
+
+#endif //MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_PRICINGROUTER_HPP
@@ -0,0 +1,88 @@
+//
+// Reports the progress of a running simulation from a background thread. Workers publish the number of paths they
+// have finished through relaxed atomic counters on their own cache lines and never wait on the reporter. The
+// reporter samples the counters at a fixed interval and prints the paths done, the throughput, the time left and
+// the running price with its standard error.
+//
+
+#include "ProgressReporter.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <utility>
+
+/**
+ * Overloaded ctor
+ * @param _sample Reads the workers' counters and the running price. Called from the reporter thread.
+ * @param intervalSeconds Time between two reports
+ * @param _out Stream the reports are written to
+ */
+ProgressReporter::ProgressReporter(std::function<ProgressSnapshot (void)> _sample, double intervalSeconds,
+                                   std::ostream& _out)
+    : sample{std::move(_sample)}, interval{intervalSeconds}, out{_out}
+{
+
+}
+
+/**
+ * Dtor. Stops the reporter thread if the client didn't.
+ */
+ProgressReporter::~ProgressReporter()
+{
+    if (thread.joinable()) stop();
+}
+
+/**
+ * Starts the reporter thread
+ */
+void ProgressReporter::start()
+{
+    started = std::chrono::steady_clock::now();
+    thread = std::thread{[this] { run(); }};
+}
+
+/**
+ * Stops the reporter thread without waiting for the current interval to run out
+ */
+void ProgressReporter::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock{mtx};
+        stopping = true;
+    }
+    cv.notify_one();
+    if (thread.joinable()) thread.join();
+}
+
+/**
+ * Reports every interval until stopped
+ */
+void ProgressReporter::run()
+{
+    std::unique_lock<std::mutex> lock{mtx};
+    while (!cv.wait_for(lock, interval, [this] { return stopping; }))
+    {
+        lock.unlock();
+        report();
+        lock.lock();
+    }
+}
+
+/**
+ * Prints one line of progress, e.g.
+ * "Progress: 1200000 / 5000000 paths (24%), 410000 paths/s, ETA 9.3 s, price 5.8463 +/- 0.0061"
+ */
+void ProgressReporter::report()
+{
+    ProgressSnapshot snapshot = sample();
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    double rate = elapsed > 0.0 ? static_cast<double>(snapshot.pathsDone - snapshot.pathsResumed) / elapsed : 0.0;
+    double percent = snapshot.pathsTotal == 0 ? 100.0 : 100.0 * snapshot.pathsDone / snapshot.pathsTotal;
+
+    out << "Progress: " << snapshot.pathsDone << " / " << snapshot.pathsTotal << " paths (" << percent << "%), "
+        << rate << " paths/s";
+    if (rate > 0.0) out << ", ETA " << static_cast<double>(snapshot.pathsTotal - snapshot.pathsDone) / rate << " s";
+    if (snapshot.pathsPriced > 0) out << ", price " << snapshot.price << " +/- " << snapshot.standardError;
+    out << std::endl;
+}
@@ -0,0 +1,60 @@
+//
+// Reports the progress of a running simulation from a background thread. Workers publish the number of paths they
+// have finished through relaxed atomic counters on their own cache lines and never wait on the reporter. The
+// reporter samples the counters at a fixed interval and prints the paths done, the throughput, the time left and
+// the running price with its standard error.
+//
+
+#ifndef MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_PROGRESSREPORTER_HPP
+#define MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_PROGRESSREPORTER_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <iosfwd>
+#include <mutex>
+#include <thread>
+
+struct ProgressSnapshot
+{
+    unsigned long pathsDone = 0;        // Paths finished so far, including resumed ones
+    unsigned long pathsTotal = 0;       // Paths of the run
+    unsigned long pathsResumed = 0;     // Paths restored from a checkpoint, excluded from the throughput
+    unsigned long pathsPriced = 0;      // Paths behind the running price
+    double price = 0.0;                 // Discounted price of the finished blocks
+    double standardError = 0.0;         // Standard error of the running price
+};
+
+class ProgressReporter
+{
+private:
+    std::function<ProgressSnapshot (void)> sample;
+    std::chrono::duration<double> interval;
+    std::ostream& out;
+    std::chrono::steady_clock::time_point started;
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool stopping = false;
+    std::thread thread;
+
+    void report();
+    void run();
+
+public:
+    ProgressReporter(std::function<ProgressSnapshot (void)> _sample, double intervalSeconds, std::ostream& _out);
+    ProgressReporter(const ProgressReporter& other) = delete;
+    ProgressReporter(ProgressReporter&& other) noexcept = delete;
+    virtual ~ProgressReporter();
+
+    // Operator Overloads
+    ProgressReporter& operator=(const ProgressReporter& other) = delete;
+    ProgressReporter& operator=(ProgressReporter&& other) noexcept = delete;
+
+    // Lifecycle
+    void start();
+    void stop();
+};
+
+
+#endif //MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_PROGRESSREPORTER_HPP
@@ -0,0 +1,37 @@
+// SDE.hpp
+//
+// Drift and diffusion terms of the Black Scholes SDE dS = (r - D)S dt + sig S dW.
+//
+// (C) Datasim Education BV 2008-2016
+
+#ifndef SDE_HPP
+#define SDE_HPP
+
+#include <memory>
+
+#include "OptionData.hpp"
+
+class SDE
+{ // Defines drift + diffusion + data
+private:
+		std::shared_ptr<OptionData> data;	// The data for the option
+public:
+	SDE(const OptionData& optionData) : data(new OptionData(optionData)) {}
+
+	double drift(double t, double S) const
+	{ // Drift term
+
+		return (data->r - data->D)*S; // r - D
+	}
+
+
+	double diffusion(double t, double S) const
+	{ // Diffusion term
+
+		return data->sig * S;
+	}
+
+};
+
+
+#endif
@@ -0,0 +1,156 @@
+//
+// Prices an option over a grid of spot and volatility shocks using common random numbers. Each worker generates
+// the Brownian increments of a small chunk of paths once, then evaluates every scenario against the same
+// increments while they are still in cache. The cost of the RNG is paid once per path rather than once per
+// scenario, and differences between neighbouring scenarios stay smooth because they share their noise.
+//
+
+#include "ScenarioGrid.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "EngineRegistry.hpp"
+#include "SDE.hpp"
+#include "WorkerPool.hpp"
+
+/**
+ * Overloaded ctor
+ * @param _optionData The unshocked option
+ * @param _config Discretisation, number of simulations, engine and thread placement of the pass. The grid always
+ *                simulates plain Euler paths on the fly, see Pricer::standalone.
+ * @param _spotShocks Relative shocks of the spot price
+ * @param _volShocks Absolute shocks of the volatility
+ * @throws std::invalid_argument if NT or NSIM is 0
+ */
+ScenarioGrid::ScenarioGrid(const OptionData& _optionData, PricerConfig _config, std::vector<double> _spotShocks,
+                           std::vector<double> _volShocks)
+    : optionData{_optionData}, config{Pricer::standalone(std::move(_config))}, spotShocks{std::move(_spotShocks)},
+      volShocks{std::move(_volShocks)}
+{
+    Pricer::validate(config);
+    if (config.blockSize == 0) config.blockSize = 1;
+    config.richardson = false;
+    if (spotShocks.empty()) spotShocks.push_back(0.0);
+    if (volShocks.empty()) volShocks.push_back(0.0);
+}
+
+/**
+ * Prices every scenario of the grid. Every block keeps its own statistics per scenario and the blocks are reduced
+ * in block order, so the result doesn't depend on the number of threads.
+ * @return One result per scenario, spot shocks varying slowest
+ */
+std::vector<ScenarioResult> ScenarioGrid::price() const
+{
+    WorkerPool pool(config, topology);
+    BlockStatistics statistics(pool.size(), spotShocks.size() * volShocks.size());
+
+    dispatchEngine(config.engine, [&](auto engine)
+    {
+        using Engine = typename decltype(engine)::type;
+        pool.run(Pricer::blockCount(config), [&](unsigned int worker, std::size_t first, std::size_t last)
+        {
+            runWorker<Engine>(first, last, statistics.allocate(worker, last - first));
+        });
+    });
+    std::vector<Accumulator> scenarios = statistics.reduce();
+
+    double discount = std::exp(-optionData.r * optionData.T);
+    std::vector<ScenarioResult> grid;
+    for (std::size_t i = 0; i < spotShocks.size(); ++i)
+    {
+        for (std::size_t j = 0; j < volShocks.size(); ++j)
+        {
+            ScenarioResult scenario;
+            scenario.spotShock = spotShocks[i];
+            scenario.volShock = volShocks[j];
+            scenario.payoffs = scenarios[i * volShocks.size() + j];
+            scenario.price = discount * scenario.payoffs.mean;
+            grid.push_back(scenario);
+        }
+    }
+
+    return grid;
+}
+
+/**
+ * Simulates the range of blocks that belongs to one worker under every scenario. Instantiated once per registered
+ * engine.
+ * @param firstBlock The first block of the worker
+ * @param lastBlock One past the last block of the worker
+ * @param blocks Receives the statistics of each block, one Accumulator per scenario
+ */
+template <typename Engine>
+void ScenarioGrid::runWorker(unsigned long firstBlock, unsigned long lastBlock, std::vector<Accumulator>& blocks) const
+{
+    // Shocked copies of the option, spot shocks varying slowest
+    std::vector<OptionData> options;
+    std::vector<SDE> sdes;
+    for (double spotShock : spotShocks)
+    {
+        for (double volShock : volShocks)
+        {
+            OptionData shocked = optionData;
+            shocked.S = optionData.S * (1.0 + spotShock);
+            shocked.sig = std::max(0.0, optionData.sig + volShock);
+            options.push_back(shocked);
+            sdes.emplace_back(shocked);
+        }
+    }
+
+    std::size_t steps = static_cast<std::size_t>(config.NT);
+    std::vector<double> path(steps);
+    std::vector<double> dW(steps * CHUNK_SIZE);      // Increments of the chunk, time step major
+    std::vector<double> V(CHUNK_SIZE);
+
+    Engine rng{config.seed};
+    long NT = config.NT;
+    double k = optionData.T / double (NT);
+    double sqrk = std::sqrt(k);
+
+    for (unsigned long b = firstBlock; b < lastBlock; ++b)
+    {
+        rng.beginBlock(b);
+        Accumulator* scenarios = blocks.data() + (b - firstBlock) * options.size();
+
+        unsigned long lastPath = std::min(config.NSIM, (b + 1) * config.blockSize);
+        for (unsigned long chunk = b * config.blockSize; chunk < lastPath; chunk += CHUNK_SIZE)
+        {
+            std::size_t paths = static_cast<std::size_t>(std::min<unsigned long>(CHUNK_SIZE, lastPath - chunk));
+
+            // The same per path streams as the Pricer, generated once for all scenarios
+            for (std::size_t p = 0; p < paths; ++p)
+            {
+                rng.fillPath(chunk + p, path.data(), steps);
+                for (std::size_t index = 0; index < steps; ++index) dW[index * CHUNK_SIZE + p] = path[index];
+            }
+
+            for (std::size_t s = 0; s < options.size(); ++s)
+            {
+                const SDE& sde = sdes[s];
+                Accumulator& payoffs = scenarios[s];
+
+                std::fill(V.begin(), V.begin() + paths, options[s].S);
+                double x = 0.0;
+                for (std::size_t index = 0; index < steps; ++index)
+                {
+                    // The FDM (in this case explicit Euler), equation (9.2) from the text, across the chunk
+                    const double* increments = dW.data() + index * CHUNK_SIZE;
+                    for (std::size_t p = 0; p < paths; ++p)
+                    {
+                        V[p] = V[p] + (k * sde.drift(x, V[p])) + (sqrk * sde.diffusion(x, V[p]) * increments[p]);
+
+                        // Spurious values
+                        if (V[p] <= 0.0) payoffs.originHits++;
+                    }
+
+                    x += k;
+                }
+
+                for (std::size_t p = 0; p < paths; ++p) payoffs.add(options[s].myPayOffFunction(V[p]));
+            }
+        }
+    }
+}
@@ -0,0 +1,57 @@
+//
+// Prices an option over a grid of spot and volatility shocks using common random numbers. Each worker generates
+// the Brownian increments of a small chunk of paths once, then evaluates every scenario against the same
+// increments while they are still in cache. The cost of the RNG is paid once per path rather than once per
+// scenario, and differences between neighbouring scenarios stay smooth because they share their noise.
+//
+
+#ifndef MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_SCENARIOGRID_HPP
+#define MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_SCENARIOGRID_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "Accumulator.hpp"
+#include "OptionData.hpp"
+#include "Pricer.hpp"
+#include "Topology.hpp"
+
+struct ScenarioResult
+{
+    double spotShock = 0.0;             // Relative shock applied to the spot price, e.g. -0.05 for -5%
+    double volShock = 0.0;              // Absolute shock applied to the volatility, e.g. 0.01 for +1 vol point
+    Accumulator payoffs;                // Statistics of the undiscounted payoffs
+    double price = 0.0;                 // Discounted price
+};
+
+class ScenarioGrid
+{
+private:
+    static constexpr std::size_t CHUNK_SIZE = 64;   // Paths whose increments are shared by all scenarios at once
+
+    OptionData optionData;
+    PricerConfig config;
+    std::vector<double> spotShocks;
+    std::vector<double> volShocks;
+    Topology topology;
+
+    template <typename Engine>
+    void runWorker(unsigned long firstBlock, unsigned long lastBlock, std::vector<Accumulator>& blocks) const;
+
+public:
+    ScenarioGrid(const OptionData& _optionData, PricerConfig _config, std::vector<double> _spotShocks,
+                 std::vector<double> _volShocks);
+    ScenarioGrid(const ScenarioGrid& other) = default;
+    ScenarioGrid(ScenarioGrid&& other) noexcept = default;
+    virtual ~ScenarioGrid() = default;
+
+    // Operator Overloads
+    ScenarioGrid& operator=(const ScenarioGrid& other) = default;
+    ScenarioGrid& operator=(ScenarioGrid&& other) noexcept = default;
+
+    // Pricing API
+    std::vector<ScenarioResult> price() const;
+};
+
+
+#endif //MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_SCENARIOGRID_HPP
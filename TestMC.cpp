@@ -12,41 +12,24 @@
 //
 
 #include "OptionData.hpp" // in local directory
-#include <random>
-#include <memory>
 #include <cmath>
+#include <exception>
 #include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
 
-#include "Rng.hpp"
+#include "CommandLine.hpp"
+#include "EngineRegistry.hpp"
+#include "PartialResult.hpp"
+#include "Pricer.hpp"
+#include "PricerOptions.hpp"
+#include "ScenarioGrid.hpp"
 
 
-class SDE
-{ // Defines drift + diffusion + data
-private:
-		std::shared_ptr<OptionData> data;	// The data for the option
-public:
-	SDE(const OptionData& optionData) : data(new OptionData(optionData)) {}
-
-	double drift(double t, double S)
-	{ // Drift term
-	
-		return (data->r - data->D)*S; // r - D
-	}
-
-	
-	double diffusion(double t, double S)
-	{ // Diffusion term
-	
-		return data->sig * S;
-	}
-
-};
-
-
-int main()
+int main(int argc, char* argv[])
 {
-    RNG rng;
-    rng.buildEngine();
+    CommandLine commandLine(argc, argv);
 
 	std::cout <<  "1 factor MC with explicit Euler\n";
 	//OptionData(double strike, double expiration, double interestRate,
@@ -54,7 +37,8 @@ int main()
 //	OptionData myOption { 100.0, 1.0, 0.06, 0.2, 0.03, 1 }; // Uniform initialisation
 	OptionData myOption((	OptionParams::strike = 65.0, OptionParams::expiration = 0.25, 
 							OptionParams::volatility = 0.3, OptionParams::dividend = 0.0, 
-							OptionParams::optionType = -1, OptionParams::interestRate = 0.08));
+							OptionParams::optionType = -1, OptionParams::interestRate = 0.08,
+							OptionParams::spotPrice = 60.0, OptionParams::NSIM = 50000ul));
 //  OptionData myOption{ 65.0, 0.25, 0.08, 0.3, 0.0, 1 }; // Uniform initialisation
 //	OptionData myOption{ 110.0, 1.0, 0.05, 0.2, 0.0, -1 }; // Uniform initialisation
 /*	myOption.K = 65.0;
@@ -72,91 +56,272 @@ int main()
 	myOption.D = 0.0;
 	myOption.type = -1;	// Put -1, Call +1*/
 
-	SDE sde(myOption);
-
-	// Initial value of SDE
-	double S_0 = 60;
-	
-	// Variables for underlying stock
-	double x;
-	double VOld = S_0;
-	double VNew;
+	// Initial value of SDE is the spot price, S_0 = 60
 
 	long NT = 100;
-	std::cout << "Number of time steps: ";
-	std::cin >> NT;
-
-	// V2 mediator stuff
 	long NSIM = 50000;
-	std::cout << "Number of simulations: ";
-	std::cin >> NSIM;
-	double M = static_cast<double>(NSIM);
-
-	double k = myOption.T / double (NT);
-	double sqrk = std::sqrt(k);
-
-	// Normal random number
-	double dW;
-	double price = 0.0;	// Option price
-	double payoffT;
-	double avgPayoffT = 0.0;
-	double squaredPayoff = 0.0;
-	double sumPriceT = 0.0;
-
-	// Normal (0,1) rng
-	std::default_random_engine dre;
-	std::normal_distribution<double> nor(0.0, 1.0);
-
-	long coun = 0; // Number of times S hits origin
-
-	for (long i = 1; i <= M; ++i)
-	{ // Calculate a path at each iteration
-			
-		if ((i/10000) * 10000 == i)
-		{// Give status after each 1000th iteration
-
-			std::cout << i << ", ";
+	try
+	{
+		if (commandLine.has("nt"))
+		{
+			NT = commandLine.getLong("nt", NT);
+		}
+		else
+		{
+			std::cout << "Number of time steps: ";
+			std::cin >> NT;
 		}
 
-		VOld = S_0;
-		x = 0.0;
-		for (long index = 0; index <= NT; ++index)
+		// V2 mediator stuff
+		if (commandLine.has("nsim"))
+		{
+			NSIM = commandLine.getLong("nsim", NSIM);
+		}
+		else
+		{
+			std::cout << "Number of simulations: ";
+			std::cin >> NSIM;
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "Unable to read the discretisation - " << e.what() << std::endl;
+		return 1;
+	}
+	// A failed console read leaves 0
+	if (NT < 1 || NSIM < 1)
+	{
+		std::cerr << "Invalid discretisation " << NT << " time steps, " << NSIM << " simulations, expected at least 1 of each"
+				  << std::endl;
+		return 1;
+	}
+
+	// Worker pool and its placement on the NUMA nodes, e.g. --pin compact, --pin scatter or --pin 0-7,16-23
+	PricerConfig config;
+	config.NT = NT;
+	config.NSIM = static_cast<unsigned long>(NSIM);
+	try
+	{
+		readWorkerOptions(commandLine, config);
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "Unable to read the worker options - " << e.what() << std::endl;
+		return 1;
+	}
+
+	// Richardson extrapolation, --richardson prices NT and 2 NT steps on the same Brownian paths
+	config.richardson = commandLine.has("richardson");
+	// The extrapolated payoff 2 f(fine) - f(coarse) isn't the payoff of any path, so there is nothing to export
+	for (const char* flag : {"export-paths", "distributions"})
+	{
+		if (config.richardson && commandLine.has(flag))
+		{
+			std::cerr << "--" << flag << " isn't supported with --richardson" << std::endl;
+			return 1;
+		}
+	}
+
+	// Random number engine, e.g. --engine mersenne-twister. --engine auto benchmarks the registered engines on this
+	// host and picks the fastest one that passes the quality gates.
+	try
+	{
+		readEngineOption(commandLine, config, std::cout);
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "Unable to select engine - " << e.what() << std::endl;
+		return 1;
+	}
+	std::cout << "Engine: " << getEngineName(config.engine) << std::endl;
+
+	// Shard mode, e.g. --shard 3/16 prices the fourth of sixteen disjoint slices of the path space
+	if (commandLine.has("shard"))
+	{
+		std::string shard = commandLine.get("shard", "0/1");
+		std::size_t slash = shard.find('/');
+		bool valid = slash != std::string::npos && slash > 0 && slash + 1 < shard.size() &&
+					 shard.find_first_not_of("0123456789/") == std::string::npos &&
+					 shard.find('/', slash + 1) == std::string::npos;
+		if (valid)
+		{
+			config.shard = static_cast<unsigned int>(std::stoul(shard.substr(0, slash)));
+			config.shards = static_cast<unsigned int>(std::stoul(shard.substr(slash + 1)));
+		}
+		if (!valid || config.shards == 0 || config.shard >= config.shards)
 		{
+			std::cerr << "Invalid shard " << shard << ", expected i/N with 0 <= i < N" << std::endl;
+			return 1;
+		}
+	}
 
-			// Create a random number
-			dW = nor(dre);
+	// Scenario grid, e.g. --spot-shocks -0.1:0.1:21 --vol-shocks -0.05:0.05:11 prices 231 scenarios on common
+	// random numbers
+	if (commandLine.has("spot-shocks") || commandLine.has("vol-shocks"))
+	{
+		// The grid prices one pass of plain Euler paths held in memory
+		for (const char* flag : {"shard", "partial", "checkpoint", "resume", "normal-pool", "richardson", "export-paths",
+								 "distributions"})
+		{
+			if (commandLine.has(flag))
+			{
+				std::cerr << "--" << flag << " isn't supported with --spot-shocks or --vol-shocks" << std::endl;
+				return 1;
+			}
+		}
 
-			// The FDM (in this case explicit Euler), equation (9.2) from the text
-			VNew = VOld + (k * sde.drift(x, VOld)) +(sqrk * sde.diffusion(x, VOld) * dW);
+		try
+		{
+			ScenarioGrid grid(myOption, config, commandLine.getGrid("spot-shocks", {0.0}), commandLine.getGrid("vol-shocks", {0.0}));
+
+			std::cout << "Spot shock, Vol shock, Price, Standard Error" << std::endl;
+			for (const auto& scenario : grid.price())
+			{
+				std::cout << scenario.spotShock << ", " << scenario.volShock << ", " << scenario.price << ", "
+						  << std::exp(-myOption.r * myOption.T) * scenario.payoffs.standardError() << std::endl;
+			}
+		}
+		catch (const std::exception& e)
+		{
+			std::cerr << "Unable to price the scenario grid - " << e.what() << std::endl;
+			return 1;
+		}
 
-			VOld = VNew;
+		return 0;
+	}
 
-			// Spurious values
-			if (VNew <= 0.0) coun++;
+	// Periodic checkpoints, e.g. --checkpoint run.ckpt --checkpoint-interval 300, and --resume run.ckpt
+	config.checkpointPath = commandLine.get("checkpoint", commandLine.get("resume", ""));
+	try
+	{
+		config.checkpointInterval = commandLine.getDouble("checkpoint-interval", config.checkpointInterval);
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "Unable to read the checkpoint options - " << e.what() << std::endl;
+		return 1;
+	}
+	if (!(config.checkpointInterval > 0.0))
+	{
+		std::cerr << "Invalid checkpoint interval " << config.checkpointInterval << ", expected a positive number of seconds"
+				  << std::endl;
+		return 1;
+	}
 
-			x += k;
+	std::vector<BlockResult> resumed;
+	if (commandLine.has("resume"))
+	{
+		try
+		{
+			PartialResult checkpoint = PartialResult::read(commandLine.get("resume", ""));
+			if (!checkpoint.samePathSpace(PartialResult{myOption, config, {}}) ||
+				checkpoint.config.shard != config.shard || checkpoint.config.shards != config.shards)
+			{
+				std::cerr << "Checkpoint was taken by a run with different parameters" << std::endl;
+				return 1;
+			}
+			resumed = std::move(checkpoint.blocks);
 		}
-			
-		// Assemble quantities (postprocessing)
-		payoffT = myOption.myPayOffFunction(VNew);
-		sumPriceT += payoffT;
-		avgPayoffT += payoffT/M;
-		avgPayoffT *= avgPayoffT;
+		catch (const std::exception& e)
+		{
+			std::cerr << "Unable to resume - " << e.what() << std::endl;
+			return 1;
+		}
+	}
 
-		squaredPayoff += (payoffT*payoffT);
+	// Pre-generated normals written by GenerateNormalPool, e.g. --normal-pool normals.pool
+	config.normalPool = commandLine.get("normal-pool", "");
+
+	// Progress reports every --progress seconds, 0 turns them off
+	try
+	{
+		config.progressInterval = commandLine.getDouble("progress", 1.0);
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "Unable to read the progress options - " << e.what() << std::endl;
+		return 1;
+	}
+	if (!(config.progressInterval >= 0.0))
+	{
+		std::cerr << "Invalid progress interval " << config.progressInterval << ", expected 0 or a positive number of seconds"
+				  << std::endl;
+		return 1;
+	}
+
+	// Distribution outputs: --export-paths paths.bin streams every terminal value and payoff to a binary file,
+	// --distributions sketches their quantiles in memory
+	config.pathExport = commandLine.get("export-paths", "");
+	config.distributions = commandLine.has("distributions");
+
+	PricerResult result;
+	try
+	{
+		result = Pricer(myOption, config, std::move(resumed)).price();
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "Unable to price - " << e.what() << std::endl;
+		return 1;
+	}
+
+	// Partial accumulators that MergeShards combines into the estimate of a single run
+	if (commandLine.has("shard") || commandLine.has("partial"))
+	{
+		std::string path = commandLine.get("partial", "");
+		if (path.empty()) path = "shard-" + std::to_string(config.shard) + "-of-" + std::to_string(config.shards) + ".part";
+
+		PartialResult{myOption, config, result.blocks}.write(path);
+		std::cout << "Partial result written to " << path << std::endl;
 	}
 	
 	// Finally, discounting the average price
-	price = std::exp(-myOption.r * myOption.T) * sumPriceT/M;
+	double price = result.price;
 
 	std::cout << "Price, after discounting: " << price << ", " << std::endl;
-	std::cout << "Number of times origin is hit: " << coun << std::endl;
+	std::cout << "Number of times origin is hit: " << result.payoffs.originHits << std::endl;
 
-	double SD = std::sqrt((squaredPayoff / M) - sumPriceT*sumPriceT/(M*M));
+	double SD = result.payoffs.standardDeviation();
 	std::cout << "Standard Deviation: " << SD << ", " << std::endl;
 
-	double SE = SD / std::sqrt(M);
+	double SE = result.payoffs.standardError();
 	std::cout << "Standard Error: " << SE << ", " << std::endl;
 
+	std::cout << "Delta: " << result.delta << ", " << std::endl;
+	std::cout << "Vega: " << result.vega << ", " << std::endl;
+	if (config.richardson)
+	{
+		std::cout << "Estimated bias of the " << NT << " step Euler price: " << result.bias << std::endl;
+	}
+
+	if (config.distributions)
+	{
+		std::cout << "Quantile, Terminal value, Payoff" << std::endl;
+		for (double q : {0.01, 0.05, 0.25, 0.5, 0.75, 0.95, 0.99})
+		{
+			std::cout << q << ", " << result.terminals.quantile(q) << ", " << result.payoffDistribution.quantile(q)
+					  << std::endl;
+		}
+	}
+
+	// Metrics
+	const PricerMetrics& metrics = result.metrics;
+	std::cout << "Wall time (s): " << metrics.wallSeconds << std::endl;
+	std::cout << "Paths per second: " << metrics.pathsSimulated / metrics.wallSeconds << std::endl;
+	if (!config.checkpointPath.empty())
+	{
+		std::cout << "Resumed blocks: " << metrics.resumedBlocks << std::endl;
+		std::cout << "Checkpoints written: " << metrics.checkpoints << ", last " << metrics.checkpointBytes
+				  << " bytes" << std::endl;
+		std::cout << "Checkpoint time (s): " << metrics.checkpointSeconds << " ("
+				  << 100.0 * metrics.checkpointSeconds / metrics.wallSeconds << "% of wall time, off the workers)"
+				  << std::endl;
+	}
+	if (!config.pathExport.empty())
+	{
+		std::cout << "Paths exported to " << config.pathExport << ": " << metrics.exportBytes << " bytes, workers waited "
+				  << metrics.exportStallSeconds << " s on the writer" << std::endl;
+	}
+
 	return 0;
 }
\ No newline at end of file
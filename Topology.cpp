@@ -0,0 +1,225 @@
+//
+// Discovers the NUMA layout of the host and maps worker threads onto CPUs. Supports compact placement (fill one
+// node before moving to the next), scatter placement (round-robin across nodes) and an explicit list of CPUs.
+//
+
+#include "Topology.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+/**
+ * Default ctor. Reads the online NUMA nodes and their CPUs from sysfs and keeps the CPUs the process may run on,
+ * so taskset and cgroup cpusets are honoured. Hosts that don't expose NUMA information are treated as a single node
+ * that owns every allowed CPU.
+ */
+Topology::Topology()
+    : allowedCpus{readAffinity()}
+{
+    for (int node : readCpuList("/sys/devices/system/node/online"))
+    {
+        std::vector<int> cpus;
+        for (int cpu : readCpuList("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist"))
+        {
+            if (allowed(cpu)) cpus.push_back(cpu);
+        }
+        if (!cpus.empty()) cpusByNode.push_back(std::move(cpus));
+    }
+
+    if (cpusByNode.empty()) cpusByNode.push_back(allowedCpus);
+}
+
+/**
+ * Reads the CPUs the calling process may run on
+ * @return The CPU ids of the affinity mask, or every hardware thread where the mask can't be read
+ */
+std::vector<int> Topology::readAffinity()
+{
+    std::vector<int> cpus;
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0)
+    {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {
+            if (CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+        }
+    }
+#endif
+
+    if (cpus.empty())
+    {
+        unsigned int hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned int cpu = 0; cpu < hardwareThreads; ++cpu) cpus.push_back(static_cast<int>(cpu));
+    }
+
+    return cpus;
+}
+
+/**
+ * Checks whether the process may run on a CPU
+ * @param cpu A CPU id
+ * @return True if the CPU is in the affinity mask of the process
+ */
+bool Topology::allowed(int cpu) const
+{
+    return std::binary_search(allowedCpus.begin(), allowedCpus.end(), cpu);
+}
+
+/**
+ * Reads a sysfs cpu/node list file
+ * @param path Location of the file
+ * @return The ids listed in the file, or an empty list when the file can't be read
+ */
+std::vector<int> Topology::readCpuList(const std::string& path)
+{
+    std::ifstream file{path};
+    std::string list;
+    if (!file || !std::getline(file, list)) return {};
+
+    try
+    {
+        return parseCpuList(list);
+    }
+    catch (const std::exception&)
+    {
+        return {};
+    }
+}
+
+/**
+ * Parses a list of CPUs in the kernel's format, e.g. "0-3,8,10-11"
+ * @param list Comma separated CPU ids and inclusive ranges
+ * @return The expanded list of CPU ids
+ * @throws std::invalid_argument if the list holds anything but CPU ids, dashes and commas
+ */
+std::vector<int> Topology::parseCpuList(const std::string& list)
+{
+    if (list.find_first_not_of("0123456789,-") != std::string::npos)
+    {
+        throw std::invalid_argument("Invalid CPU list: " + list);
+    }
+
+    std::vector<int> cpus;
+    std::stringstream stream{list};
+    std::string token;
+    while (std::getline(stream, token, ','))
+    {
+        if (token.empty()) continue;
+
+        std::size_t dash = token.find('-');
+        if (dash == 0 || dash + 1 == token.size() || token.find('-', dash + 1) != std::string::npos)
+        {
+            throw std::invalid_argument("Invalid CPU range: " + token);
+        }
+        int first = std::stoi(token.substr(0, dash));
+        int last = dash == std::string::npos ? first : std::stoi(token.substr(dash + 1));
+        if (last < first) throw std::invalid_argument("Invalid CPU range: " + token);
+
+        for (int cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+    }
+
+    return cpus;
+}
+
+/**
+ * Utility function that allows clients to lookup a PinningPolicy by its description
+ * @param desc One of none, compact or scatter, or a CPU list such as 0-7,16-23
+ * @return The matching PinningPolicy
+ * @throws std::invalid_argument for any other description
+ */
+PinningPolicy Topology::getPinningPolicyFromString(const std::string& desc)
+{
+    if (desc == "none") return PinningPolicy::NONE;
+    if (desc == "compact") return PinningPolicy::COMPACT;
+    if (desc == "scatter") return PinningPolicy::SCATTER;
+    if (!desc.empty() && desc.find_first_not_of("0123456789,-") == std::string::npos) return PinningPolicy::EXPLICIT;
+
+    throw std::invalid_argument("Unknown pinning policy " + desc + ", expected none, compact, scatter or a CPU list");
+}
+
+/**
+ * Maps each worker onto a CPU.
+ * @param policy How workers should be spread across the NUMA nodes
+ * @param threads Number of workers
+ * @param cpus The CPUs to use when the policy is EXPLICIT. Workers wrap around when there are more workers than CPUs.
+ * @return The CPU of each worker, or -1 for workers that should be left to the scheduler
+ * @throws std::invalid_argument if an explicit CPU is outside the affinity mask of the process
+ */
+std::vector<int> Topology::placement(PinningPolicy policy, unsigned int threads, const std::vector<int>& cpus) const
+{
+    std::vector<int> result(threads, -1);
+    if (policy == PinningPolicy::EXPLICIT)
+    {
+        for (int cpu : cpus)
+        {
+            if (!allowed(cpu)) throw std::invalid_argument("CPU " + std::to_string(cpu) + " isn't available to this process");
+        }
+    }
+
+    if (policy == PinningPolicy::COMPACT)
+    {
+        std::vector<int> ordered;
+        for (const auto& node : cpusByNode) ordered.insert(ordered.end(), node.begin(), node.end());
+        for (unsigned int i = 0; i < threads; ++i) result[i] = ordered[i % ordered.size()];
+    }
+    else if (policy == PinningPolicy::SCATTER)
+    {
+        for (unsigned int i = 0; i < threads; ++i)
+        {
+            const auto& node = cpusByNode[i % cpusByNode.size()];
+            result[i] = node[(i / cpusByNode.size()) % node.size()];
+        }
+    }
+    else if (policy == PinningPolicy::EXPLICIT && !cpus.empty())
+    {
+        for (unsigned int i = 0; i < threads; ++i) result[i] = cpus[i % cpus.size()];
+    }
+
+    return result;
+}
+
+/**
+ * Binds the calling thread to a single CPU. Memory the thread touches afterwards is placed on that CPU's node by
+ * the kernel's first-touch policy.
+ * @param cpu The CPU to bind to. Negative values leave the thread unpinned.
+ * @return True if the thread was pinned or left unpinned on purpose. False if pinning failed.
+ */
+bool Topology::pinCurrentThread(int cpu)
+{
+    if (cpu < 0) return true;
+
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Binds the calling worker thread to its CPU and warns when the kernel refuses, in which case the worker runs
+ * unpinned and its memory may be placed on another node
+ * @param cpu The CPU of the worker. Negative values leave the worker unpinned.
+ */
+void Topology::pinWorker(int cpu)
+{
+    if (!pinCurrentThread(cpu))
+    {
+        std::cerr << "Warning: unable to pin a worker to CPU " + std::to_string(cpu) + ", it runs unpinned\n";
+    }
+}
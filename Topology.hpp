@@ -0,0 +1,51 @@
+//
+// Discovers the NUMA layout of the host and maps worker threads onto CPUs. Supports compact placement (fill one
+// node before moving to the next), scatter placement (round-robin across nodes) and an explicit list of CPUs.
+//
+
+#ifndef MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_TOPOLOGY_HPP
+#define MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_TOPOLOGY_HPP
+
+#include <string>
+#include <vector>
+
+enum class PinningPolicy
+{
+    NONE,
+    COMPACT,
+    SCATTER,
+    EXPLICIT
+};
+
+class Topology
+{
+private:
+    std::vector<int> allowedCpus;                 // CPUs in the affinity mask of the process, ascending
+    std::vector<std::vector<int>> cpusByNode;     // Allowed CPUs grouped by the NUMA node that owns them
+
+    static std::vector<int> readCpuList(const std::string& path);
+    static std::vector<int> readAffinity();
+    bool allowed(int cpu) const;
+
+public:
+    Topology();
+    Topology(const Topology& other) = default;
+    Topology(Topology&& other) noexcept = default;
+    virtual ~Topology() = default;
+
+    // Operator Overloads
+    Topology& operator=(const Topology& other) = default;
+    Topology& operator=(Topology&& other) noexcept = default;
+
+    // Placement API
+    std::vector<int> placement(PinningPolicy policy, unsigned int threads, const std::vector<int>& cpus) const;
+    static bool pinCurrentThread(int cpu);
+    static void pinWorker(int cpu);
+
+    // Utilities
+    static std::vector<int> parseCpuList(const std::string& list);
+    static PinningPolicy getPinningPolicyFromString(const std::string& desc);
+};
+
+
+#endif //MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_TOPOLOGY_HPP
@@ -0,0 +1,78 @@
+//
+// Worker threads of a pricing pass and the block ordered reduction of their statistics. A pass splits its items
+// (blocks, or the pending blocks of a resumed run) into one contiguous range per worker in worker order. Each worker
+// is pinned according to the PinningPolicy before it runs, so the memory it allocates is placed on its own NUMA
+// node by the kernel's first-touch policy. BlockStatistics keeps one or more Accumulators per block, allocated by
+// the worker that owns the block, and folds them in block order as PartialResult::reduce does, so the result of a
+// pass doesn't depend on the number of workers.
+//
+
+#include "WorkerPool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * Overloaded ctor
+ * @param config Number of workers and their placement. A pool has at least one worker.
+ * @param topology The NUMA layout the workers are placed on
+ * @throws std::invalid_argument if an explicit CPU is outside the affinity mask of the process
+ */
+WorkerPool::WorkerPool(const PricerConfig& config, const Topology& topology)
+    : threads{std::max(1u, config.threads)}, cpus{topology.placement(config.pinning, threads, config.cpus)}
+{
+
+}
+
+/**
+ * The items that belong to one worker. The ranges ascend with the worker index and only depend on the number of
+ * items and workers, so every pass over the same items gives a worker the same range.
+ * @param worker Index of the worker
+ * @param items Number of items of the pass
+ * @return The first and one past the last item of the worker
+ */
+std::pair<std::size_t, std::size_t> WorkerPool::range(unsigned int worker, std::size_t items) const
+{
+    return {items * worker / threads, items * (worker + 1) / threads};
+}
+
+/**
+ * Overloaded ctor
+ * @param _workers Number of workers of the pass
+ * @param _width Accumulators per block, e.g. one per scenario or option priced on the block's paths
+ */
+BlockStatistics::BlockStatistics(unsigned int _workers, std::size_t _width)
+    : width{_width}, workers(_workers)
+{
+
+}
+
+/**
+ * Allocates the statistics of a worker's blocks. Called by the worker itself, after it has been pinned.
+ * @param worker Index of the worker
+ * @param blocks Number of blocks of the worker
+ * @return width Accumulators per block, block b of the worker's range starting at b * width
+ */
+std::vector<Accumulator>& BlockStatistics::allocate(unsigned int worker, std::size_t blocks)
+{
+    workers[worker].assign(blocks * width, Accumulator{});
+    return workers[worker];
+}
+
+/**
+ * Folds the blocks in index order. The workers' ranges ascend with the worker index, so visiting the workers in
+ * order visits the blocks in order.
+ * @return The statistics of all blocks, one Accumulator per column
+ */
+std::vector<Accumulator> BlockStatistics::reduce() const
+{
+    std::vector<Accumulator> result(width);
+    for (const auto& blocks : workers)
+    {
+        for (std::size_t i = 0; i < blocks.size(); ++i) result[i % width].merge(blocks[i]);
+    }
+
+    return result;
+}
@@ -0,0 +1,96 @@
+//
+// Worker threads of a pricing pass and the block ordered reduction of their statistics. A pass splits its items
+// (blocks, or the pending blocks of a resumed run) into one contiguous range per worker in worker order. Each worker
+// is pinned according to the PinningPolicy before it runs, so the memory it allocates is placed on its own NUMA
+// node by the kernel's first-touch policy. BlockStatistics keeps one or more Accumulators per block, allocated by
+// the worker that owns the block, and folds them in block order as PartialResult::reduce does, so the result of a
+// pass doesn't depend on the number of workers.
+//
+
+#ifndef MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_WORKERPOOL_HPP
+#define MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_WORKERPOOL_HPP
+
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Accumulator.hpp"
+#include "Pricer.hpp"
+#include "Topology.hpp"
+
+class WorkerPool
+{
+private:
+    unsigned int threads;
+    std::vector<int> cpus;
+
+public:
+    WorkerPool(const PricerConfig& config, const Topology& topology);
+    WorkerPool(const WorkerPool& other) = default;
+    WorkerPool(WorkerPool&& other) noexcept = default;
+    virtual ~WorkerPool() = default;
+
+    // Operator Overloads
+    WorkerPool& operator=(const WorkerPool& other) = default;
+    WorkerPool& operator=(WorkerPool&& other) noexcept = default;
+
+    // Pool API
+    inline unsigned int size() const {return threads;}
+    std::pair<std::size_t, std::size_t> range(unsigned int worker, std::size_t items) const;
+
+    /**
+     * Runs one pass and waits for every worker to finish
+     * @param items Number of items of the pass
+     * @param body Called on each pinned worker as body(worker, firstItem, lastItem)
+     * @throws std::system_error if a worker can't be started, once the workers already started have finished
+     */
+    template <typename Body>
+    void run(std::size_t items, Body body) const
+    {
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        try
+        {
+            for (unsigned int worker = 0; worker < threads; ++worker)
+            {
+                auto [first, last] = range(worker, items);
+                workers.emplace_back([&body, cpu = cpus[worker], worker, first = first, last = last]
+                {
+                    Topology::pinWorker(cpu);
+                    body(worker, first, last);
+                });
+            }
+        }
+        catch (...)
+        {
+            for (auto& worker : workers) worker.join();
+            throw;
+        }
+        for (auto& worker : workers) worker.join();
+    }
+};
+
+class BlockStatistics
+{
+private:
+    std::size_t width;
+    std::vector<std::vector<Accumulator>> workers;  // Statistics of each worker's blocks, block major
+
+public:
+    BlockStatistics(unsigned int _workers, std::size_t _width);
+    BlockStatistics(const BlockStatistics& other) = default;
+    BlockStatistics(BlockStatistics&& other) noexcept = default;
+    virtual ~BlockStatistics() = default;
+
+    // Operator Overloads
+    BlockStatistics& operator=(const BlockStatistics& other) = default;
+    BlockStatistics& operator=(BlockStatistics&& other) noexcept = default;
+
+    // Reduction API
+    std::vector<Accumulator>& allocate(unsigned int worker, std::size_t blocks);
+    std::vector<Accumulator> reduce() const;
+};
+
+
+#endif //MULTI_THREADED_MONTE_CARLO_SIMULATION_FOR_OPTION_PRICING_WORKERPOOL_HPP
@@ -0,0 +1,129 @@
+// Pricing.cpp
+//
+// Regression test of the pricing methods. The closed forms must reproduce textbook prices and put-call parity, the
+// European lattice must converge to Black Scholes, an American put must be worth at least its European put, and the
+// router must send each request to the method that serves it. Richardson extrapolation must remove most of the bias
+// of a coarse Euler discretisation on a fixed seed.
+//
+
+#include <cmath>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "BlackScholes.hpp"
+#include "Lattice.hpp"
+#include "OptionData.hpp"
+#include "Pricer.hpp"
+#include "PricingRouter.hpp"
+
+namespace
+{
+    bool check(const std::string& name, bool passed, double expected, double actual)
+    {
+        std::cout << (passed ? "PASSED " : "FAILED ") << name << " (expected " << expected << ", got " << actual
+                  << ")" << std::endl;
+        return passed;
+    }
+
+    bool near(const std::string& name, double expected, double actual, double tolerance)
+    {
+        return check(name, std::abs(expected - actual) <= tolerance, expected, actual);
+    }
+}
+
+int main()
+{
+    try
+    {
+        bool passed = true;
+
+        // Hull's examples, quoted to the cent: a call and a put on a stock, a call on an index paying a dividend
+        // yield and a put on a futures contract
+        OptionData call{40.0, 0.5, 0.1, 0.2, 42.0, 0ul, 0.0, 1};
+        OptionData put{40.0, 0.5, 0.1, 0.2, 42.0, 0ul, 0.0, -1};
+        passed &= near("black scholes call", 4.76, blackScholes(call).price, 0.005);
+        passed &= near("black scholes put", 0.81, blackScholes(put).price, 0.005);
+        passed &= near("black scholes dividend call", 51.83,
+                       blackScholes(OptionData{900.0, 2.0 / 12.0, 0.08, 0.2, 930.0, 0ul, 0.03, 1}).price, 0.005);
+        OptionData futuresCall{20.0, 4.0 / 12.0, 0.09, 0.25, 20.0, 0ul, 0.0, 1};
+        OptionData futuresPut{20.0, 4.0 / 12.0, 0.09, 0.25, 20.0, 0ul, 0.0, -1};
+        passed &= near("black 76 put", 1.12, black76(futuresPut).price, 0.005);
+
+        // Put-call parity: C - P = S exp(-D T) - K exp(-r T) on a stock, and exp(-r T) (F - K) on a future
+        OptionData dividendCall{110.0, 0.5, 0.05, 0.25, 100.0, 0ul, 0.03, 1};
+        OptionData dividendPut{110.0, 0.5, 0.05, 0.25, 100.0, 0ul, 0.03, -1};
+        passed &= near("black scholes parity",
+                       dividendCall.S * std::exp(-dividendCall.D * dividendCall.T) -
+                       dividendCall.K * std::exp(-dividendCall.r * dividendCall.T),
+                       blackScholes(dividendCall).price - blackScholes(dividendPut).price, 1e-10);
+        passed &= near("black 76 parity", std::exp(-futuresCall.r * futuresCall.T) * (futuresCall.S - futuresCall.K),
+                       black76(futuresCall).price - black76(futuresPut).price, 1e-10);
+
+        // The CRR lattice converges to Black Scholes at O(1 / steps)
+        double exact = blackScholes(dividendCall).price;
+        double coarse = std::abs(binomialLattice(dividendCall, false, 50).price - exact);
+        double fine = std::abs(binomialLattice(dividendCall, false, 2000).price - exact);
+        passed &= check("lattice converges", fine < coarse && fine < 2e-3, exact,
+                        binomialLattice(dividendCall, false, 2000).price);
+
+        // Early exercise of an in the money put is worth something
+        OptionData itmPut{110.0, 1.0, 0.05, 0.25, 100.0, 0ul, 0.0, -1};
+        double american = binomialLattice(itmPut, true, 1000).price;
+        double european = binomialLattice(itmPut, false, 1000).price;
+        passed &= check("american put above european", american > european && american > blackScholes(itmPut).price,
+                        european, american);
+
+        // Routing: an American call without dividends is worth the European call, an American put needs the lattice,
+        // and the simulation can't price early exercise
+        PricerConfig routerConfig;
+        routerConfig.NT = 10;
+        routerConfig.NSIM = 1000;
+        routerConfig.threads = 1;
+        PricingRouter router{routerConfig};
+
+        PricingRequest americanCall{call, ExerciseStyle::AMERICAN};
+        PricingResponse response = router.price(americanCall);
+        passed &= check("american call routed to closed form", response.method == PricingMethod::CLOSED_FORM &&
+                        response.price == blackScholes(call).price, blackScholes(call).price, response.price);
+
+        PricingRequest americanPut{itmPut, ExerciseStyle::AMERICAN};
+        response = router.price(americanPut);
+        passed &= check("american put routed to lattice", response.method == PricingMethod::LATTICE, american,
+                        response.price);
+
+        americanPut.method = PricingMethod::MONTE_CARLO;
+        bool rejected = false;
+        try
+        {
+            router.price(americanPut);
+        }
+        catch (const std::invalid_argument&)
+        {
+            rejected = true;
+        }
+        passed &= check("american monte carlo rejected", rejected, 1.0, rejected ? 1.0 : 0.0);
+
+        // Richardson extrapolation on 10 steps of a high volatility put, whose Euler bias is over ten standard errors
+        OptionData biased{100.0, 2.0, 0.1, 0.6, 100.0, 100000ul, 0.0, -1};
+        PricerConfig config;
+        config.NT = 10;
+        config.NSIM = biased.NSIM;
+        config.threads = 1;
+        config.seed = 42;
+        double reference = blackScholes(biased).price;
+        double euler = Pricer(biased, config).price().price;
+        config.richardson = true;
+        double richardson = Pricer(biased, config).price().price;
+        passed &= check("richardson shrinks the 10 step error",
+                        std::abs(richardson - reference) < 0.5 * std::abs(euler - reference), reference, richardson);
+
+        return passed ? 0 : 1;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Unable to run the pricing test - " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,200 @@
+// Reproducibility.cpp
+//
+// Regression test of the bit-identical guarantees. A run is priced once with one worker, and its partial result
+// file must be reproduced byte for byte with several workers, by merging two shards, by resuming from a checkpoint
+// that holds some of its blocks and by reading the normals from a pre-generated pool. The passes that price several
+// options on the same paths must give the same statistics for any number of workers.
+//
+
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Calibrator.hpp"
+#include "NormalPool.hpp"
+#include "OptionChain.hpp"
+#include "OptionData.hpp"
+#include "PartialResult.hpp"
+#include "Pricer.hpp"
+#include "ScenarioGrid.hpp"
+
+namespace
+{
+    const std::string PREFIX = "reproducibility-";
+
+    std::string contents(const std::string& path)
+    {
+        std::ifstream in{path, std::ios::binary};
+        if (!in) throw std::runtime_error("Unable to open " + path);
+
+        return {std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+    }
+
+    // Writes the partial result of a run and returns the file's bytes
+    std::string partial(const OptionData& optionData, const PricerConfig& config, std::vector<BlockResult> blocks,
+                        const std::string& name)
+    {
+        std::string path = PREFIX + name + ".part";
+        PartialResult{optionData, config, std::move(blocks)}.write(path);
+        std::string bytes = contents(path);
+        std::remove(path.c_str());
+
+        return bytes;
+    }
+
+    bool check(const std::string& name, const std::string& expected, const std::string& actual)
+    {
+        std::cout << (expected == actual ? "PASSED " : "FAILED ") << name << std::endl;
+        return expected == actual;
+    }
+
+    // The exact state of an Accumulator, for byte comparisons. Greeks are left out for passes that don't
+    // compute them.
+    std::string bytes(const Accumulator& a, bool greeks = true)
+    {
+        std::ostringstream out;
+        out << std::hexfloat << a.count << ' ' << a.mean << ' ' << a.M2 << ' ' << a.originHits;
+        if (greeks) out << ' ' << a.deltaMean << ' ' << a.vegaMean << ' ' << a.biasMean;
+        out << '\n';
+        return out.str();
+    }
+}
+
+int main()
+{
+    try
+    {
+        OptionData optionData{65.0, 0.25, 0.08, 0.3, 60.0, 0ul, 0.0, -1};
+
+        // Ten blocks, the last one partial
+        PricerConfig config;
+        config.NT = 20;
+        config.NSIM = 9 * config.blockSize + 123;
+        config.threads = 1;
+        config.seed = 42;
+
+        PricerResult single = Pricer(optionData, config).price();
+        std::string expected = partial(optionData, config, single.blocks, "single");
+        bool passed = true;
+
+        // 1 vs N workers
+        PricerConfig threaded = config;
+        threaded.threads = 4;
+        passed &= check("4 threads", expected,
+                        partial(optionData, config, Pricer(optionData, threaded).price().blocks, "threads"));
+
+        // 2 shards written to disk and merged vs 1 run
+        std::vector<PartialResult> shards;
+        for (unsigned int shard = 0; shard < 2; ++shard)
+        {
+            PricerConfig sharded = threaded;
+            sharded.shard = shard;
+            sharded.shards = 2;
+            std::string path = PREFIX + "shard-" + std::to_string(shard) + ".part";
+            PartialResult{optionData, sharded, Pricer(optionData, sharded).price().blocks}.write(path);
+            shards.push_back(PartialResult::read(path));
+            std::remove(path.c_str());
+        }
+        PartialResult merged = PartialResult::merge(shards);
+        passed &= check("2 shards merged", expected, partial(optionData, config, merged.blocks, "merged"));
+
+        // Resume from a checkpoint holding every other block vs no resume. The resumed run checkpoints again while
+        // it prices the missing blocks.
+        std::vector<BlockResult> finished;
+        for (const auto& block : single.blocks)
+        {
+            if (block.index % 2 == 0) finished.push_back(block);
+        }
+        std::string checkpoint = PREFIX + "checkpoint.part";
+        PartialResult{optionData, config, finished}.write(checkpoint);
+
+        PricerConfig resumed = threaded;
+        resumed.checkpointPath = checkpoint;
+        resumed.checkpointInterval = 0.001;
+        PricerResult result = Pricer(optionData, resumed, PartialResult::read(checkpoint).blocks).price();
+        std::remove(checkpoint.c_str());
+        passed &= check("resume", expected, partial(optionData, config, result.blocks, "resumed"));
+        passed &= check("resumed blocks", std::to_string(finished.size()),
+                        std::to_string(result.metrics.resumedBlocks));
+
+        // Pre-generated normals vs on the fly
+        std::string pool = PREFIX + "normals.pool";
+        NormalPool::generate(pool, config.seed, config.NSIM, static_cast<std::uint64_t>(config.NT), 2);
+        PricerConfig pooled = threaded;
+        pooled.normalPool = pool;
+        std::string fromPool = partial(optionData, config, Pricer(optionData, pooled).price().blocks, "pool");
+        std::remove(pool.c_str());
+        passed &= check("normal pool", expected, fromPool);
+
+        // Scenario grid with 1 vs N workers, and its unshocked scenario vs the plain run
+        std::vector<double> spotShocks{-0.1, 0.0, 0.1}, volShocks{-0.05, 0.0, 0.05};
+        std::string grids[2];
+        for (unsigned int threads : {1u, 4u})
+        {
+            PricerConfig gridConfig = config;
+            gridConfig.threads = threads;
+            for (const auto& scenario : ScenarioGrid(optionData, gridConfig, spotShocks, volShocks).price())
+            {
+                grids[threads == 4] += bytes(scenario.payoffs);
+            }
+        }
+        passed &= check("scenario grid 4 threads", grids[0], grids[1]);
+        Accumulator unshocked = ScenarioGrid(optionData, config, {0.0}, {0.0}).price().front().payoffs;
+        passed &= check("unshocked scenario", bytes(single.payoffs, false), bytes(unshocked, false));
+
+        // Calibration passes with 1 vs N workers, and the first pass at the option's own vol vs the plain run
+        std::vector<CalibrationQuote> quotes{{optionData, 5.0, 1.0},
+                                             {OptionData{60.0, 0.5, 0.08, 0.3, 60.0, 0ul, 0.0, 1}, 5.5, 1.0}};
+        std::string fits[2];
+        for (unsigned int threads : {1u, 4u})
+        {
+            CalibrationConfig calibration;
+            calibration.pricer = config;
+            calibration.pricer.threads = threads;
+            CalibrationResult fit = Calibrator(quotes, calibration).fitVolatility();
+            std::ostringstream out;
+            out << std::hexfloat << fit.vols.front() << ' ' << fit.prices[0] << ' ' << fit.prices[1] << '\n';
+            fits[threads == 4] = out.str();
+        }
+        passed &= check("calibration 4 threads", fits[0], fits[1]);
+        CalibrationConfig firstPass;
+        firstPass.pricer = threaded;
+        firstPass.maxIterations = 0;
+        CalibrationResult implied = Calibrator({quotes.front()}, firstPass).impliedVolatilities();
+        std::ostringstream price;
+        price << std::hexfloat << single.price;
+        std::ostringstream calibrated;
+        calibrated << std::hexfloat << implied.prices.front();
+        passed &= check("calibration pass", price.str(), calibrated.str());
+
+        // Option chain with 1 vs N workers, two expiries and both types on one path set
+        std::vector<OptionData> options{optionData, OptionData{60.0, 0.25, 0.08, 0.3, 60.0, 0ul, 0.0, 1},
+                                        OptionData{65.0, 0.5, 0.08, 0.3, 60.0, 0ul, 0.0, -1}};
+        std::string chains[2];
+        for (unsigned int threads : {1u, 4u})
+        {
+            PricerConfig chainConfig = config;
+            chainConfig.threads = threads;
+            for (const auto& result : OptionChain(options, chainConfig).price())
+            {
+                chains[threads == 4] += bytes(result.payoffs);
+            }
+        }
+        passed &= check("option chain 4 threads", chains[0], chains[1]);
+
+        return passed ? 0 : 1;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Unable to run the reproducibility test - " << e.what() << std::endl;
+        return 1;
+    }
+}